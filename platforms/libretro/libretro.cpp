@@ -63,12 +63,18 @@ static int current_screen_height = 0;
 static float current_aspect_ratio = 0.0f;
 static float aspect_ratio = 0.0f;
 static float current_fps = 60.0f;
+static int sample_rate = GLYNX_AUDIO_SAMPLE_RATE;
+static int current_sample_rate = GLYNX_AUDIO_SAMPLE_RATE;
 
 static bool allow_up_down = false;
+static bool fastforward_audio = true;
+static bool late_input_poll = false;
+static bool input_polled = false;
 static bool categories_supported = false;
 static bool content_info_ext_supported = false;
 
 static bool libretro_supports_bitmasks = false;
+static bool libretro_supports_dupe = false;
 static int joypad_current[MAX_PADS][JOYPAD_BUTTONS];
 static int joypad_old[MAX_PADS][JOYPAD_BUTTONS];
 static unsigned input_device[MAX_PADS] = {
@@ -96,6 +102,7 @@ static void clear_input_state(void);
 static void reset_controller_devices(void);
 static void apply_controller_device(unsigned port, unsigned device, bool log_device);
 static void update_input(void);
+static void input_poll_callback(void* user_data);
 static void check_variables(void);
 
 static void fallback_log(enum retro_log_level level, const char *fmt, ...)
@@ -282,10 +289,11 @@ void retro_init(void)
 
     core = new GearlynxCore();
 
-    core->Init(GLYNX_PIXEL_RGB565);
+    core->Init(GLYNX_PIXEL_XRGB8888);
+    core->GetMikey()->GetLcdScreen()->SetDirtyLineConversion(true);
     core->GetRuntimeInfo(runtime_info);
 
-    frame_buffer = new u8[256 * 256 * 2];
+    frame_buffer = new u8[256 * 256 * 4];
 
     clear_input_state();
 
@@ -293,6 +301,9 @@ void retro_init(void)
         apply_controller_device(i, input_device[i], false);
 
     libretro_supports_bitmasks = environ_cb(RETRO_ENVIRONMENT_GET_INPUT_BITMASKS, NULL);
+
+    if (!environ_cb(RETRO_ENVIRONMENT_GET_CAN_DUPE, &libretro_supports_dupe))
+        libretro_supports_dupe = false;
 }
 
 void retro_deinit(void)
@@ -309,6 +320,7 @@ void retro_deinit(void)
     aspect_ratio = 0.0f;
     current_fps = 60.0f;
     libretro_supports_bitmasks = false;
+    libretro_supports_dupe = false;
 
     reset_controller_devices();
     clear_input_state();
@@ -356,7 +368,8 @@ void retro_get_system_av_info(struct retro_system_av_info *info)
     info->geometry.max_height   = GLYNX_SCREEN_WIDTH;
     info->geometry.aspect_ratio = aspect_ratio == 0.0f ? (float)runtime_info.screen_width / (float)runtime_info.screen_height : aspect_ratio;
     info->timing.fps            = current_fps;
-    info->timing.sample_rate    = 44100.0;
+    info->timing.sample_rate    = (double)sample_rate;
+    current_sample_rate = sample_rate;
 }
 
 void retro_run(void)
@@ -365,25 +378,39 @@ void retro_run(void)
     if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE_UPDATE, &core_options_updated) && core_options_updated)
         check_variables();
 
-    update_input();
+    input_polled = false;
+    if (!late_input_poll)
+        update_input();
+
+    // Sound channels keep running while fast-forwarding, only the samples are skipped
+    bool fastforwarding = false;
+    if (!fastforward_audio)
+        environ_cb(RETRO_ENVIRONMENT_GET_FASTFORWARDING, &fastforwarding);
+    core->GetAudio()->SetSkipSamples(fastforwarding);
 
     audio_sample_count = 0;
     core->RunToVBlank(frame_buffer, audio_buf, &audio_sample_count);
 
+    // Frames that never read JOYSTICK or SWITCHES still poll once
+    if (!input_polled)
+        update_input();
+
     core->GetRuntimeInfo(runtime_info);
 
     float new_fps = runtime_info.frame_time > 0.0f ? (1000.0f / runtime_info.frame_time) : 60.0f;
     bool fps_changed = fabsf(new_fps - current_fps) > 0.1f;
+    bool sample_rate_changed = (sample_rate != current_sample_rate);
     bool geometry_changed = (runtime_info.screen_width != current_screen_width) ||
                             (runtime_info.screen_height != current_screen_height) ||
                             (aspect_ratio != current_aspect_ratio);
 
-    if (fps_changed || geometry_changed)
+    if (fps_changed || sample_rate_changed || geometry_changed)
     {
         current_screen_width = runtime_info.screen_width;
         current_screen_height = runtime_info.screen_height;
         current_aspect_ratio = aspect_ratio;
         current_fps = new_fps;
+        current_sample_rate = sample_rate;
 
         retro_system_av_info info;
         info.geometry.base_width   = runtime_info.screen_width;
@@ -392,11 +419,11 @@ void retro_run(void)
         info.geometry.max_height   = GLYNX_SCREEN_WIDTH;
         info.geometry.aspect_ratio = (aspect_ratio == 0.0f ? (float)runtime_info.screen_width / (float)runtime_info.screen_height : aspect_ratio);
         info.timing.fps            = current_fps;
-        info.timing.sample_rate    = 44100.0;
+        info.timing.sample_rate    = (double)current_sample_rate;
 
-        if (fps_changed)
+        if (fps_changed || sample_rate_changed)
         {
-            log_cb(RETRO_LOG_INFO, "Refresh rate changed to %.2f Hz\n", current_fps);
+            log_cb(RETRO_LOG_INFO, "Timing changed to %.2f Hz, audio %d Hz\n", current_fps, current_sample_rate);
             environ_cb(RETRO_ENVIRONMENT_SET_SYSTEM_AV_INFO, &info);
         }
         else
@@ -405,7 +432,9 @@ void retro_run(void)
         }
     }
 
-    video_cb((uint8_t*)frame_buffer, runtime_info.screen_width, runtime_info.screen_height, runtime_info.screen_width * sizeof(u8) * 2);
+    // Let the frontend reuse the previous frame when no line changed
+    bool dupe = libretro_supports_dupe && !geometry_changed && !core->GetMikey()->GetLcdScreen()->IsFrameDirty();
+    video_cb(dupe ? NULL : (uint8_t*)frame_buffer, runtime_info.screen_width, runtime_info.screen_height, runtime_info.screen_width * sizeof(u8) * 4);
 
     if (audio_sample_count > 0)
         audio_batch_cb(audio_buf, audio_sample_count / 2);
@@ -507,10 +536,10 @@ bool retro_load_game(const struct retro_game_info *info)
         log_cb(RETRO_LOG_WARN, "%s.\n", msg.msg);
     }
 
-    enum retro_pixel_format fmt = RETRO_PIXEL_FORMAT_RGB565;
+    enum retro_pixel_format fmt = RETRO_PIXEL_FORMAT_XRGB8888;
     if (!environ_cb(RETRO_ENVIRONMENT_SET_PIXEL_FORMAT, &fmt))
     {
-        log_cb(RETRO_LOG_ERROR, "RGB565 is not supported.\n");
+        log_cb(RETRO_LOG_ERROR, "XRGB8888 is not supported.\n");
         return false;
     }
 
@@ -663,10 +692,17 @@ static void apply_controller_device(unsigned port, unsigned device, bool log_dev
     }
 }
 
+static void input_poll_callback(void* user_data)
+{
+    UNUSED(user_data);
+    update_input();
+}
+
 static void update_input(void)
 {
     int16_t joypad_bits[MAX_PADS];
 
+    input_polled = true;
     input_poll_cb();
 
     if (libretro_supports_bitmasks)
@@ -905,6 +941,13 @@ static void check_variables(void)
         fast_sprite_rendering = strcmp(var.value, "Enabled") == 0;
     core->GetSuzy()->SetFastSpriteRendering(fast_sprite_rendering);
 
+    var.key = "gearlynx_audio_sample_rate";
+    var.value = NULL;
+
+    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+        sample_rate = atoi(var.value);
+    core->GetAudio()->SetSampleRate(sample_rate);
+
     var.key = "gearlynx_lowpass_filter";
     var.value = NULL;
 
@@ -914,6 +957,30 @@ static void check_variables(void)
         core->GetAudio()->SetLowpassCutoff(fc);
     }
 
+    var.key = "gearlynx_input_poll";
+    var.value = NULL;
+
+    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+    {
+        if (strcmp(var.value, "Late") == 0)
+            late_input_poll = true;
+        else
+            late_input_poll = false;
+    }
+
+    core->SetInputPollCallback(late_input_poll ? input_poll_callback : NULL, NULL);
+
+    var.key = "gearlynx_fastforward_audio";
+    var.value = NULL;
+
+    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+    {
+        if (strcmp(var.value, "Disabled") == 0)
+            fastforward_audio = false;
+        else
+            fastforward_audio = true;
+    }
+
     for (int i = 0; i < 4; i++)
     {
         char key[64];
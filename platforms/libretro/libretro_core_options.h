@@ -171,6 +171,21 @@ struct retro_core_option_v2_definition option_defs_us[] = {
 
     /* Audio */
 
+    {
+        "gearlynx_audio_sample_rate",
+        "Audio Sample Rate (Hz)",
+        "Sample Rate (Hz)",
+        "Set the audio output rate. Audio is synthesized band-limited at any rate; higher rates keep more of the high-frequency content of the Lynx channels.",
+        "Set the audio output rate.",
+        "audio",
+        {
+            { "44100", NULL },
+            { "48000", NULL },
+            { "96000", NULL },
+            { NULL, NULL },
+        },
+        "44100"
+    },
     {
         "gearlynx_lowpass_filter",
         "Audio Low-Pass Filter (Hz)",
@@ -325,6 +340,20 @@ struct retro_core_option_v2_definition option_defs_us[] = {
         },
         "100"
     },
+    {
+        "gearlynx_fastforward_audio",
+        "Audio During Fast-Forward",
+        "Fast-Forward Audio",
+        "Keep synthesizing audio while the frontend is fast-forwarding. Disabling it still clocks the Lynx sound channels, but skips sample generation and filtering to run faster.",
+        "Synthesize audio while fast-forwarding.",
+        "audio",
+        {
+            { "Enabled",  NULL },
+            { "Disabled", NULL },
+            { NULL, NULL },
+        },
+        "Enabled"
+    },
 
     /* Input */
 
@@ -342,6 +371,20 @@ struct retro_core_option_v2_definition option_defs_us[] = {
         },
         "Disabled"
     },
+    {
+        "gearlynx_input_poll",
+        "Input Polling",
+        NULL,
+        "Early reads the controllers before each frame runs. Late reads them the first time the game reads JOYSTICK or SWITCHES, which is usually mid-frame, and can save up to a frame of input latency.",
+        NULL,
+        "input",
+        {
+            { "Early", NULL },
+            { "Late",  NULL },
+            { NULL, NULL },
+        },
+        "Early"
+    },
 
     { NULL, NULL, NULL, NULL, NULL, NULL, {{0}}, NULL },
 };
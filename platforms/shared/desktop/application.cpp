@@ -27,6 +27,8 @@
 #include "gui_debug_disassembler.h"
 #include "ogl_renderer.h"
 #include "emu.h"
+#include "emu_thread.h"
+#include "frame_profiler.h"
 #include "display.h"
 #include "utils.h"
 #include "single_instance.h"
@@ -47,6 +49,10 @@ static bool paused_when_focus_lost = false;
 static Uint64 mouse_last_motion_time = 0;
 static const Uint64 mouse_hide_timeout_ms = 1500;
 static SDL_DisplayID current_display_id = 0;
+static bool events_received = false;
+static int idle_frames = 0;
+static const int k_idle_grace_frames = 30;
+static const Sint32 k_idle_wait_ms = 250;
 
 bool g_mcp_stdio_mode = false;
 
@@ -59,6 +65,11 @@ static void handle_mouse_cursor(void);
 static void handle_menu(void);
 static void handle_single_instance(void);
 static void run_emulator(void);
+static void update_emu_thread(void);
+static bool can_idle(void);
+static bool can_skip_present(void);
+static void update_frame_profiler(void);
+static void wait_for_events(void);
 static void save_window_size(void);
 
 
@@ -179,6 +190,7 @@ void application_destroy(void)
     macos_remove_dock_menu();
 #endif
 
+    emu_thread_stop();
     save_window_size();
     ogl_renderer_destroy();
     ImGui_ImplSDL3_Shutdown();
@@ -195,13 +207,30 @@ void application_mainloop(void)
 
     while (running)
     {
+        update_emu_thread();
+        wait_for_events();
+        display_frame_delay();
         display_begin_frame();
+        emu_thread_lock();
+        update_frame_profiler();
         sdl_events();
         handle_mouse_cursor();
         handle_menu();
         handle_single_instance();
         run_emulator();
-        display_render();
+
+        if (can_skip_present())
+        {
+            emu_thread_unlock();
+            display_skip_present();
+        }
+        else
+        {
+            display_render();
+            emu_thread_unlock();
+            display_present();
+        }
+
         display_frame_throttle();
     }
 }
@@ -501,6 +530,8 @@ static void sdl_events(void)
 
     while (SDL_PollEvent(&event))
     {
+        events_received = true;
+
         bool file_dialog_active = gui_file_dialog_is_active();
 
         sdl_events_quit(&event);
@@ -612,16 +643,85 @@ static void sdl_events_app(const SDL_Event* event)
 
 static void run_emulator(void)
 {
+    emu_pump_commands();
+
     if (!display_should_run_emu_frame())
         return;
 
     config_emulator.paused = emu_is_paused();
     emu_audio_sync = config_audio.sync;
-    emu_update();
+    emu_audio_set_dynamic_rate(config_audio.dynamic_rate && !config_emulator.ffwd && display_should_use_vsync());
+    emu_thread_request_frame();
 
     display_update_vsync_state();
 }
 
+static void update_emu_thread(void)
+{
+    if (config_emulator.emu_thread == emu_thread_is_running())
+        return;
+
+    if (config_emulator.emu_thread)
+    {
+        if (!emu_thread_start())
+            config_emulator.emu_thread = false;
+    }
+    else
+        emu_thread_stop();
+}
+
+// Runs with the emulation thread locked so the emu stage of the
+// previous host frame is complete when it is committed
+static void update_frame_profiler(void)
+{
+    frame_profiler_set_enabled(config_emulator.show_frame_profiler);
+    frame_profiler_commit();
+}
+
+static bool can_idle(void)
+{
+    if (!config_video.idle_power_save)
+        return false;
+    if (!emu_is_empty() && !emu_is_paused())
+        return false;
+    if (config_debug.debug)
+        return false;
+    if (emu_mcp_is_running() || emu_debug_monitor_is_running())
+        return false;
+    if (emu_comlynx_get_status().mode == ComLynxModeConnected)
+        return false;
+
+    return true;
+}
+
+// Once nothing is running and the GUI has had a few frames to settle
+// after the last input, block until the next event. The timeout keeps
+// the mouse cursor auto-hide and the single instance check alive.
+static void wait_for_events(void)
+{
+    if (events_received)
+        idle_frames = 0;
+    else if (idle_frames < k_idle_grace_frames)
+        idle_frames++;
+
+    events_received = false;
+
+    if ((idle_frames >= k_idle_grace_frames) && can_idle())
+        SDL_WaitEventTimeout(NULL, k_idle_wait_ms);
+}
+
+// A running game whose screen did not change since the last present is
+// not drawn or swapped again while the GUI has nothing to update either
+static bool can_skip_present(void)
+{
+    if (!config_video.idle_power_save || config_debug.debug)
+        return false;
+    if (idle_frames < k_idle_grace_frames)
+        return false;
+
+    return gui_is_idle() && ogl_renderer_is_frame_unchanged();
+}
+
 static void save_window_size(void)
 {
     if (!config_emulator.fullscreen)
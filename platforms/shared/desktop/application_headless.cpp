@@ -134,6 +134,7 @@ void application_headless_mainloop(void)
     {
         Uint64 frame_start = SDL_GetPerformanceCounter();
 
+        emu_pump_commands();
         emu_update();
         gui_debug_update();
         gui_finish_loading_rom();
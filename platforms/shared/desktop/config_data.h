@@ -89,8 +89,10 @@ struct config_Emulator
     bool ffwd;
     int ffwd_speed;
     int runahead;
+    bool emu_thread;
     bool fast_sprite_rendering;
     bool show_info;
+    bool show_frame_profiler;
     std::string recent_roms[config_max_recent_roms];
     std::string bios_path;
     int savefiles_dir_option;
@@ -121,6 +123,8 @@ struct config_Video
     int rotation;
     bool fps;
     int sync_mode;
+    bool frame_delay;
+    bool idle_power_save;
     float background_color[config_Theme_Count][3];
     float background_color_debugger[config_Theme_Count][3];
     int shader_mode;
@@ -131,10 +135,12 @@ struct config_Audio
 {
     bool enable;
     bool sync;
+    bool dynamic_rate;
     float master_volume;
     float volume[4];
     int lowpass_cutoff;
     int buffer_count;
+    int sample_rate;
 };
 
 struct config_Rewind
@@ -240,6 +246,7 @@ struct config_Debug
     int scb_viewer_mode;
     bool show_frame_buffers;
     int frame_buffer_custom_address;
+    int view_refresh_rate;
     bool show_lcd;
     bool show_uart;
     bool show_comlynx;
@@ -53,6 +53,7 @@ static inline void process(config_Operation operation)
     CONFIG_INT("Debug", "SCBViewerMode", config_debug.scb_viewer_mode, 1);
     CONFIG_BOOL("Debug", "FrameBuffers", config_debug.show_frame_buffers, false);
     CONFIG_INT("Debug", "FrameBufferCustomAddress", config_debug.frame_buffer_custom_address, 0x0000);
+    CONFIG_INT_RANGE("Debug", "ViewRefreshRate", config_debug.view_refresh_rate, 10, 0, 60);
     CONFIG_BOOL("Debug", "LCD", config_debug.show_lcd, false);
     CONFIG_BOOL("Debug", "UART", config_debug.show_uart, false);
     CONFIG_BOOL("Debug", "ComLynx", config_debug.show_comlynx, false);
@@ -146,6 +147,7 @@ static inline void process(config_Operation operation)
     // Emulation
     CONFIG_INT("Emulator", "FFWD", config_emulator.ffwd_speed, 1);
     CONFIG_INT_RANGE("Emulator", "RunAhead", config_emulator.runahead, 0, 0, 3);
+    CONFIG_BOOL("Emulator", "EmulationThread", config_emulator.emu_thread, false);
     CONFIG_INT_RANGE("Emulator", "SaveSlot", config_emulator.save_slot, 0, 0, 4);
     CONFIG_BOOL("Emulator", "LegacySpriteRendering", config_emulator.fast_sprite_rendering, false);
     CONFIG_BOOL("Emulator", "StartPaused", config_emulator.start_paused, false);
@@ -204,6 +206,8 @@ static inline void process(config_Operation operation)
     }
 
     CONFIG_INT_RANGE("Video", "SyncMode", config_video.sync_mode, config_VideoSync_Disabled, config_VideoSync_Disabled, config_VideoSync_VRR);
+    CONFIG_BOOL("Video", "FrameDelay", config_video.frame_delay, false);
+    CONFIG_BOOL("Video", "IdlePowerSave", config_video.idle_power_save, true);
 
     // Background colors
     CONFIG_FLOAT("Video", "BackgroundColorR", config_video.background_color[config_Theme_Dark][0], 0.1f);
@@ -225,10 +229,12 @@ static inline void process(config_Operation operation)
 
     CONFIG_BOOL("Audio", "Enable", config_audio.enable, true);
     CONFIG_BOOL("Audio", "Sync", config_audio.sync, true);
+    CONFIG_BOOL("Audio", "DynamicRate", config_audio.dynamic_rate, true);
     CONFIG_FLOAT_RANGE("Audio", "MasterVolume", config_audio.master_volume, 1.0f, 0.0f, 2.0f);
     CONFIG_FLOAT_ARRAY("Audio", "Channel%dVolume", config_audio.volume, 4, 1.0f);
     CONFIG_INT("Audio", "LowpassCutoff", config_audio.lowpass_cutoff, 3000);
     CONFIG_INT("Audio", "BufferCount", config_audio.buffer_count, 3);
+    CONFIG_INT_RANGE("Audio", "SampleRate", config_audio.sample_rate, 0, 0, 2);
 
     //**************************************
     // Rewind
@@ -344,6 +350,7 @@ static void after_defaults(void)
     config_emulator.paused = false;
     config_emulator.ffwd = false;
     config_emulator.show_info = false;
+    config_emulator.show_frame_profiler = false;
 }
 
 static void normalize(void)
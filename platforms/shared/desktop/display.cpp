@@ -17,6 +17,7 @@
  *
  */
 
+#include <math.h>
 #include <SDL3/SDL.h>
 #include "imgui.h"
 #include "imgui_impl_sdl3.h"
@@ -25,6 +26,8 @@
 #include "gui.h"
 #include "ogl_renderer.h"
 #include "emu.h"
+#include "emu_thread.h"
+#include "frame_profiler.h"
 #include "application.h"
 
 #define DISPLAY_IMPORT
@@ -33,15 +36,35 @@
 static Uint64 frame_time_start = 0;
 static Uint64 frame_time_end = 0;
 static int monitor_refresh_rate = 60;
+static float monitor_refresh_hz = 60.0f;
 static int vsync_frames_per_emu_frame = 1;
 static int vsync_frame_counter = 0;
 static int last_vsync_state = -1;
 static bool multi_monitor_mixed_refresh = false;
 static bool last_vsync_forced_off = false;
 static bool pending_gl_context_recreate = false;
+static float frame_throttle_min = 0.0f;
+
+static const float k_dynamic_rate_tolerance = 0.003f;
+
+static const int k_frame_delay_window = 120;
+static const float k_frame_delay_min_slack = 2.0f;
+static const float k_frame_delay_safe_margin = 2.0f;
+static float frame_delay_ms = 0.0f;
+static bool frame_delay_measuring = false;
+static bool frame_delay_missed = false;
+static int frame_delay_samples = 0;
+static int frame_delay_histogram[DISPLAY_FRAME_DELAY_HISTOGRAM_SIZE] = { };
+static float frame_delay_histogram_snapshot[DISPLAY_FRAME_DELAY_HISTOGRAM_SIZE] = { };
+static Uint64 frame_swap_start = 0;
+static Uint64 frame_swap_end = 0;
+static Uint64 frame_swap_end_previous = 0;
 
 static bool display_is_vrr_enabled(void);
 static void display_set_swap_interval(bool enabled);
+static void update_frame_throttle(void);
+static bool is_frame_delay_active(void);
+static void update_frame_delay(void);
 
 void display_begin_frame(void)
 {
@@ -52,55 +75,84 @@ void display_render(void)
 {
     ogl_renderer_begin_render();
     ImGui_ImplSDL3_NewFrame();
+    Uint64 gui_start = frame_profiler_begin();
     gui_render();
+    frame_profiler_end(FrameProfilerStage_Gui, gui_start);
     ogl_renderer_render();
+    update_frame_throttle();
+}
+
+void display_present(void)
+{
+    Uint64 gui_start = frame_profiler_begin();
+    ogl_renderer_render_gui();
     ogl_renderer_end_render();
+    frame_profiler_end(FrameProfilerStage_Gui, gui_start);
 
+    frame_swap_start = SDL_GetPerformanceCounter();
     SDL_GL_SwapWindow(application_sdl_window);
+    frame_swap_end_previous = frame_swap_end;
+    frame_swap_end = SDL_GetPerformanceCounter();
+
+    if (frame_profiler_is_enabled())
+        frame_profiler_add(FrameProfilerStage_Swap, (float)((double)(frame_swap_end - frame_swap_start) * 1000.0 / (double)SDL_GetPerformanceFrequency()));
+}
+
+void display_skip_present(void)
+{
+    update_frame_throttle();
+
+    // Nothing blocks on vsync without a swap, so the throttle paces the
+    // loop at the refresh rate instead
+    if (last_vsync_state == 1)
+        frame_throttle_min = MAX(frame_throttle_min, 1000.0f / monitor_refresh_hz);
+
+    frame_delay_measuring = false;
+    frame_swap_end = 0;
+}
+
+void display_frame_delay(void)
+{
+    if (!is_frame_delay_active())
+    {
+        frame_delay_ms = 0.0f;
+        frame_delay_measuring = false;
+        frame_delay_missed = false;
+        frame_delay_samples = 0;
+        return;
+    }
+
+    if (frame_delay_measuring)
+        update_frame_delay();
+
+    frame_delay_measuring = true;
+
+    if (frame_delay_ms >= 1.0f)
+        SDL_DelayPrecise((Uint64)(frame_delay_ms * 1000000.0f));
+}
+
+float display_get_frame_delay_ms(void)
+{
+    return frame_delay_ms;
+}
+
+const float* display_get_frame_delay_histogram(void)
+{
+    return frame_delay_histogram_snapshot;
 }
 
 void display_frame_throttle(void)
 {
     frame_time_end = SDL_GetPerformanceCounter();
 
-    if (emu_is_empty() || emu_is_paused() || emu_is_debug_idle() || !emu_is_audio_open() || config_emulator.ffwd)
+    if (frame_throttle_min > 0.0f)
     {
         Uint64 count_per_sec = SDL_GetPerformanceFrequency();
         float elapsed = (float)(frame_time_end - frame_time_start) / (float)count_per_sec;
         elapsed *= 1000.0f;
 
-        float min = 16.666f;
-
-        if (!emu_is_audio_open())
-        {
-            GLYNX_Runtime_Info runtime;
-            emu_get_runtime(runtime);
-            min = runtime.frame_time;
-        }
-
-        if (config_emulator.ffwd)
-        {
-            switch (config_emulator.ffwd_speed)
-            {
-                case 0:
-                    min = 16.666f / 1.5f;
-                    break;
-                case 1:
-                    min = 16.666f / 2.0f;
-                    break;
-                case 2:
-                    min = 16.666f / 2.5f;
-                    break;
-                case 3:
-                    min = 16.666f / 3.0f;
-                    break;
-                default:
-                    min = 0.0f;
-            }
-        }
-
-        if (elapsed < min)
-            SDL_Delay((Uint32)(min - elapsed));
+        if (elapsed < frame_throttle_min)
+            SDL_Delay((Uint32)(frame_throttle_min - elapsed));
     }
 }
 
@@ -144,6 +196,16 @@ bool display_should_use_vsync(void)
 
     GLYNX_Runtime_Info runtime;
     emu_get_runtime(runtime);
+
+    // With dynamic rate control the audio absorbs a small mismatch,
+    // so any game rate close to the refresh (or a divisor of it) can lock to vsync
+    if (config_audio.dynamic_rate)
+    {
+        float emu_hz = (runtime.frame_time > 0.0f) ? (1000.0f / runtime.frame_time) : 60.0f;
+        float vsync_hz = monitor_refresh_hz / (float)vsync_frames_per_emu_frame;
+        return fabsf((emu_hz / vsync_hz) - 1.0f) <= k_dynamic_rate_tolerance;
+    }
+
     int emu_fps = (runtime.frame_time > 0.0f) ? (int)(1000.0f / runtime.frame_time) : 60;
     return (emu_fps >= 58 && emu_fps <= 62);
 }
@@ -214,9 +276,15 @@ void display_update_frame_pacing(void)
 
     const SDL_DisplayMode* mode = SDL_GetCurrentDisplayMode(display);
     if (mode && mode->refresh_rate > 0)
+    {
         monitor_refresh_rate = (int)mode->refresh_rate;
+        monitor_refresh_hz = mode->refresh_rate;
+    }
     else
+    {
         monitor_refresh_rate = 60;
+        monitor_refresh_hz = 60.0f;
+    }
 
     const int emu_fps = 60;
 
@@ -341,3 +409,117 @@ static void display_set_swap_interval(bool enabled)
 
     last_vsync_state = enabled ? 1 : 0;
 }
+
+static void update_frame_throttle(void)
+{
+    frame_throttle_min = 0.0f;
+
+    if (emu_is_empty() || emu_is_paused() || emu_is_debug_idle() || !emu_is_audio_open() || config_emulator.ffwd)
+    {
+        float min = 16.666f;
+
+        if (!emu_is_audio_open())
+        {
+            GLYNX_Runtime_Info runtime;
+            emu_get_runtime(runtime);
+            min = runtime.frame_time;
+        }
+
+        // Batched fast-forward runs several frames per host frame, see
+        // emu_update(). The debugger and ComLynx still run one frame per
+        // host frame, so they shorten the host frame instead
+        if (config_emulator.ffwd && emu_is_fast_forward_batched())
+            min = (config_emulator.ffwd_speed <= 3) ? 16.666f : 0.0f;
+        else if (config_emulator.ffwd)
+        {
+            switch (config_emulator.ffwd_speed)
+            {
+                case 0:
+                    min = 16.666f / 1.5f;
+                    break;
+                case 1:
+                    min = 16.666f / 2.0f;
+                    break;
+                case 2:
+                    min = 16.666f / 2.5f;
+                    break;
+                case 3:
+                    min = 16.666f / 3.0f;
+                    break;
+                default:
+                    min = 0.0f;
+            }
+        }
+
+        frame_throttle_min = min;
+    }
+}
+
+static bool is_frame_delay_active(void)
+{
+    if (!config_video.frame_delay || emu_thread_is_running())
+        return false;
+
+    if (config_video.sync_mode != config_VideoSync_Fixed || last_vsync_state != 1 || vsync_frames_per_emu_frame != 1)
+        return false;
+
+    return !emu_is_empty() && !emu_is_paused() && !emu_is_debug_idle() && !config_emulator.ffwd;
+}
+
+// Slack is what was left of the refresh interval when the previous frame
+// was submitted. The delay grows while the worst slack in the window stays
+// comfortable and backs off on any missed vsync
+static void update_frame_delay(void)
+{
+    if (frame_swap_end_previous == 0)
+        return;
+
+    float count_per_ms = (float)SDL_GetPerformanceFrequency() / 1000.0f;
+    float interval = 1000.0f / monitor_refresh_hz;
+    float busy = (float)(frame_swap_start - frame_swap_end_previous) / count_per_ms;
+    float period = (float)(frame_swap_end - frame_swap_end_previous) / count_per_ms;
+    float slack = interval - busy;
+
+    int bucket = CLAMP((int)slack, 0, DISPLAY_FRAME_DELAY_HISTOGRAM_SIZE - 1);
+    frame_delay_histogram[bucket]++;
+    frame_delay_samples++;
+
+    if (period > (interval * 1.5f))
+    {
+        frame_delay_missed = true;
+        frame_delay_ms = MAX(frame_delay_ms - 2.0f, 0.0f);
+    }
+
+    if (frame_delay_samples < k_frame_delay_window)
+        return;
+
+    int low_slack_bucket = 0;
+    int low_slack_threshold = k_frame_delay_window / 20;
+    int accumulated = 0;
+
+    for (int i = 0; i < DISPLAY_FRAME_DELAY_HISTOGRAM_SIZE; i++)
+    {
+        accumulated += frame_delay_histogram[i];
+        if (accumulated > low_slack_threshold)
+        {
+            low_slack_bucket = i;
+            break;
+        }
+    }
+
+    float max_delay = MAX(interval - k_frame_delay_safe_margin, 0.0f);
+
+    if (!frame_delay_missed && (low_slack_bucket >= (int)(k_frame_delay_min_slack + 1.0f)))
+        frame_delay_ms = MIN(frame_delay_ms + 1.0f, max_delay);
+    else if (low_slack_bucket < (int)k_frame_delay_min_slack)
+        frame_delay_ms = MAX(frame_delay_ms - 1.0f, 0.0f);
+
+    for (int i = 0; i < DISPLAY_FRAME_DELAY_HISTOGRAM_SIZE; i++)
+    {
+        frame_delay_histogram_snapshot[i] = (float)frame_delay_histogram[i] / (float)frame_delay_samples;
+        frame_delay_histogram[i] = 0;
+    }
+
+    frame_delay_samples = 0;
+    frame_delay_missed = false;
+}
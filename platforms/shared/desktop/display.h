@@ -28,10 +28,17 @@
     #define EXTERN extern
 #endif
 
+#define DISPLAY_FRAME_DELAY_HISTOGRAM_SIZE 17
+
 EXTERN SDL_GLContext display_gl_context;
 
 EXTERN void display_begin_frame(void);
 EXTERN void display_render(void);
+EXTERN void display_present(void);
+EXTERN void display_skip_present(void);
+EXTERN void display_frame_delay(void);
+EXTERN float display_get_frame_delay_ms(void);
+EXTERN const float* display_get_frame_delay_histogram(void);
 EXTERN void display_frame_throttle(void);
 EXTERN bool display_should_run_emu_frame(void);
 EXTERN bool display_should_use_vsync(void);
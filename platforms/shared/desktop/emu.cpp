@@ -29,6 +29,7 @@
 #include "config.h"
 #include "rewind.h"
 #include "runahead.h"
+#include "frame_profiler.h"
 #include "events.h"
 #include "gui_debug_trace_logger.h"
 #include "mcp/mcp_manager.h"
@@ -44,6 +45,10 @@
 
 static GearlynxCore* core;
 static s16* audio_buffer;
+static s16* audio_pending_buffer;
+static int audio_pending_count;
+static bool audio_pending_sync;
+static bool audio_deferred;
 static bool audio_enabled;
 static McpManager* mcp_manager;
 static ComLynxManager* comlynx_manager;
@@ -52,7 +57,17 @@ static u16 input_raw_directions = 0;
 static u16 input_active_directions = 0;
 static const int k_frame_buffer_size = 256 * 256 * 4;
 static Uint64 rewind_last_counter = 0;
+static Uint64 speed_last_counter = 0;
+static u64 speed_last_cycles = 0;
+static float speed = 0.0f;
+static float ffwd_frame_accumulator = 0.0f;
+static const float k_ffwd_unlimited_budget_ms = 14.0f;
+static const int k_ffwd_max_frames = 100;
 static double rewind_pop_accumulator = 0.0;
+static u32 debug_view_frame = 0;
+static u32 debug_view_seen[Debug_View_Count];
+static bool debug_view_dirty[Debug_View_Count];
+static Uint64 debug_view_last_refresh[Debug_View_Count];
 static DebugMonitorServer* debug_monitor;
 static FramebufferServer* fb_server;
 
@@ -72,11 +87,18 @@ static char loading_file_path[4096];
 static void save_ram(void);
 static void load_ram(void);
 static void reset_buffers(void);
+static void write_audio(int count, bool sync);
+static void run_fast_forward_frames(void);
+static void update_speed(void);
+static void collect_frame_profile(Uint64 start, float debug_ms);
 static const char* get_configurated_dir(int option, const char* path);
 static void init_debug(void);
 static void destroy_debug(void);
 static void reset_debug(void);
 static void update_debug(void);
+static void refresh_debug_views(void);
+static bool is_debug_view_due(Debug_View view);
+static void complete_debug_view(Debug_View view);
 static void update_debug_framebuffers(void);
 static void update_debug_sprites(void);
 static void update_debug_sprites_accumulated(void);
@@ -114,12 +136,17 @@ bool emu_init(void)
 
     emu_frame_buffer = new u8[k_frame_buffer_size];
     audio_buffer = new s16[GLYNX_AUDIO_BUFFER_SIZE];
+    audio_pending_buffer = new s16[GLYNX_AUDIO_BUFFER_SIZE];
+    audio_pending_count = 0;
+    audio_pending_sync = false;
+    audio_deferred = false;
 
     init_debug();
     reset_buffers();
 
     core = new GearlynxCore();
     core->Init();
+    core->GetMikey()->GetLcdScreen()->SetDirtyLineConversion(true);
 
     comlynx_manager = new ComLynxManager();
     comlynx_manager->SetNormalBarrierStallUs((u32)config_emulator.comlynx_stall_us);
@@ -140,6 +167,7 @@ bool emu_init(void)
     emu_debug_command = Debug_Command_None;
     emu_debug_pc_changed = false;
     emu_debug_step_frames_pending = 0;
+    emu_debug_sprite_profiler = false;
     emu_frame_counter = 0;
     for (int i = 0; i < 8; i++)
         emu_debug_irq_breakpoints[i] = false;
@@ -173,6 +201,7 @@ void emu_destroy(void)
     SafeDelete(mcp_manager);
     SafeDelete(comlynx_manager);
     SafeDeleteArray(audio_buffer);
+    SafeDeleteArray(audio_pending_buffer);
     sound_queue_destroy();
     SafeDelete(core);
     SafeDeleteArray(emu_frame_buffer);
@@ -276,17 +305,21 @@ void emu_update(void)
     if (loading_state.load() != Loading_State_None)
         return;
 
-    emu_mcp_pump_commands();
-    emu_debug_monitor_pump_commands();
     emu_comlynx_pump();
 
     if (emu_is_empty())
         return;
 
+    core->SetFrameProfileEnabled(frame_profiler_is_enabled());
+    Uint64 profile_start = frame_profiler_begin();
+    float profile_debug_ms = 0.0f;
+
     int sampleCount = 0;
     bool frame_executed = false;
     bool frame_completed = false;
 
+    core->GetAudio()->SetChannelBuffersEnabled(config_debug.debug && config_debug.show_psg);
+
     if (!emu_comlynx_is_active() && rewind_is_active())
     {
         int to_pop = get_rewind_pop_budget();
@@ -303,9 +336,9 @@ void emu_update(void)
         if (rewound)
             emu_render_current_frame();
 
-        int silence_count = GLYNX_AUDIO_QUEUE_SIZE;
+        int silence_count = emu_audio_queue_size();
         memset(audio_buffer, 0, silence_count * sizeof(s16));
-        sound_queue_write(audio_buffer, silence_count, false);
+        write_audio(silence_count, false);
         return;
     }
 
@@ -374,8 +407,14 @@ void emu_update(void)
             emu_debug_monitor_notify_stopped(breakpoint_hit, pc);
         }
 
+        Uint64 debug_start = frame_profiler_begin();
+
         if (executed)
             update_debug();
+        else
+            refresh_debug_views();
+
+        profile_debug_ms = frame_profiler_end(FrameProfilerStage_Debug, debug_start);
     }
     else
     {
@@ -383,6 +422,9 @@ void emu_update(void)
         {
             rewind_commit_seek();
 
+            if (emu_is_fast_forward_batched())
+                run_fast_forward_frames();
+
             int runahead = emu_comlynx_is_active() ? 0 : runahead_get_frames();
             if (runahead > 0)
                 runahead_run(runahead, emu_frame_buffer, audio_buffer, &sampleCount);
@@ -399,24 +441,178 @@ void emu_update(void)
         if (frame_completed)
             emu_frame_counter++;
         rewind_push();
+
+        if (core->GetMikey()->GetLcdScreen()->IsFrameDirty())
+            emu_frame_generation++;
     }
 
+    if (frame_profiler_is_enabled())
+        collect_frame_profile(profile_start, profile_debug_ms);
+
     if ((sampleCount > 0) && !core->IsPaused())
     {
         bool sync_audio = emu_audio_sync &&
             (!emu_comlynx_is_active() || comlynx_manager->IsPacingPeer());
-        sound_queue_write(audio_buffer, sampleCount, sync_audio);
+        write_audio(sampleCount, sync_audio);
     }
     else if (core->IsPaused())
     {
-        int silence_count = GLYNX_AUDIO_QUEUE_SIZE;
+        int silence_count = emu_audio_queue_size();
         memset(audio_buffer, 0, silence_count * sizeof(s16));
-        sound_queue_write(audio_buffer, silence_count, false);
+        write_audio(silence_count, false);
     }
 
+    update_speed();
     emu_debug_monitor_push_frame();
 }
 
+// MCP and debug monitor commands change GUI and display state, so they
+// run on the main thread and never from the emulation thread
+void emu_pump_commands(void)
+{
+    if (loading_state.load() != Loading_State_None)
+        return;
+
+    emu_mcp_pump_commands();
+    emu_debug_monitor_pump_commands();
+}
+
+float emu_get_speed(void)
+{
+    return speed;
+}
+
+// Runs the frames of a fast-forward step that nobody will see or hear,
+// the caller then runs the presented frame as usual
+static void run_fast_forward_frames(void)
+{
+    int frames = 0;
+    bool unlimited = false;
+
+    switch (config_emulator.ffwd_speed)
+    {
+        case 0:
+            ffwd_frame_accumulator += 1.5f;
+            break;
+        case 1:
+            ffwd_frame_accumulator += 2.0f;
+            break;
+        case 2:
+            ffwd_frame_accumulator += 2.5f;
+            break;
+        case 3:
+            ffwd_frame_accumulator += 3.0f;
+            break;
+        default:
+            unlimited = true;
+            break;
+    }
+
+    if (unlimited)
+    {
+        ffwd_frame_accumulator = 0.0f;
+        frames = k_ffwd_max_frames;
+    }
+    else
+    {
+        frames = (int)ffwd_frame_accumulator;
+        ffwd_frame_accumulator -= (float)frames;
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 budget = (Uint64)((k_ffwd_unlimited_budget_ms * (float)SDL_GetPerformanceFrequency()) / 1000.0f);
+    int dummy_count = 0;
+
+    core->GetAudio()->SetSkipSamples(true);
+
+    for (int i = 1; i < frames; i++)
+    {
+        core->RunToVBlank(emu_frame_buffer, audio_buffer, &dummy_count, NULL, false);
+        emu_frame_counter++;
+        rewind_push();
+
+        if (unlimited && ((SDL_GetPerformanceCounter() - start) >= budget))
+            break;
+    }
+
+    core->GetAudio()->SetSkipSamples(false);
+}
+
+// The emu stage is what is left of the emulation time once the core
+// components, when measured, and the debugger update are taken out
+static void collect_frame_profile(Uint64 start, float debug_ms)
+{
+    const GLYNX_Frame_Profile* profile = core->GetFrameProfile();
+
+    float cpu_ms = (float)(profile->cpu_ns / 1000000.0);
+    float suzy_ms = (float)(profile->suzy_ns / 1000000.0);
+    float mikey_ms = (float)(profile->mikey_ns / 1000000.0);
+    float audio_ms = (float)(profile->audio_ns / 1000000.0);
+    float lcd_ms = (float)(profile->lcd_ns / 1000000.0);
+    float total_ms = (float)((double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+    float emu_ms = total_ms - debug_ms - cpu_ms - suzy_ms - mikey_ms - audio_ms - lcd_ms;
+
+    frame_profiler_set_core_components(profile->components);
+    frame_profiler_add(FrameProfilerStage_Emu, MAX(emu_ms, 0.0f));
+    frame_profiler_add(FrameProfilerStage_Cpu, cpu_ms);
+    frame_profiler_add(FrameProfilerStage_Suzy, suzy_ms);
+    frame_profiler_add(FrameProfilerStage_Mikey, mikey_ms);
+    frame_profiler_add(FrameProfilerStage_Audio, audio_ms);
+    frame_profiler_add(FrameProfilerStage_Lcd, lcd_ms);
+
+    core->ResetFrameProfile();
+}
+
+static void update_speed(void)
+{
+    Uint64 now = SDL_GetPerformanceCounter();
+    u64 cycles = core->GetTotalCycles();
+
+    if ((speed_last_counter == 0) || (cycles < speed_last_cycles))
+    {
+        speed_last_counter = now;
+        speed_last_cycles = cycles;
+        return;
+    }
+
+    double elapsed = (double)(now - speed_last_counter) / (double)SDL_GetPerformanceFrequency();
+
+    if (elapsed < 0.5)
+        return;
+
+    speed = (float)(((double)(cycles - speed_last_cycles) / elapsed) / (double)GLYNX_MASTER_CLOCK);
+    speed_last_counter = now;
+    speed_last_cycles = cycles;
+}
+
+void emu_set_deferred_audio(bool deferred)
+{
+    audio_deferred = deferred;
+    audio_pending_count = 0;
+}
+
+void emu_flush_audio(void)
+{
+    if (audio_pending_count > 0)
+    {
+        sound_queue_write(audio_pending_buffer, audio_pending_count, audio_pending_sync);
+        audio_pending_count = 0;
+    }
+}
+
+static void write_audio(int count, bool sync)
+{
+    if (audio_deferred)
+    {
+        memcpy(audio_pending_buffer, audio_buffer, count * sizeof(s16));
+        audio_pending_count = count;
+        audio_pending_sync = sync;
+        return;
+    }
+
+    sound_queue_write(audio_buffer, count, sync);
+}
+
 static void reset_rewind_timing(void)
 {
     rewind_last_counter = 0;
@@ -531,6 +727,10 @@ void emu_key_released(GLYNX_Keys key)
 void emu_clear_frame_buffer(void)
 {
     memset(emu_frame_buffer, 0, k_frame_buffer_size);
+    emu_frame_generation++;
+
+    if (IsValidPointer(core))
+        core->GetMikey()->GetLcdScreen()->InvalidateFrame();
 }
 
 void emu_pause(void)
@@ -553,6 +753,29 @@ bool emu_is_debug_idle(void)
     return config_debug.debug && (emu_debug_command == Debug_Command_None);
 }
 
+bool emu_is_fast_forward_batched(void)
+{
+    return config_emulator.ffwd && !config_debug.debug && !emu_comlynx_is_active();
+}
+
+void emu_debug_views_begin_frame(void)
+{
+    debug_view_frame++;
+}
+
+// Called by the debug windows every GUI frame they are actually drawn,
+// collapsed or hidden docked windows stop asking for data
+void emu_debug_view_visible(Debug_View view)
+{
+    debug_view_seen[view] = debug_view_frame;
+}
+
+void emu_debug_view_invalidate(Debug_View view)
+{
+    debug_view_dirty[view] = true;
+    debug_view_last_refresh[view] = 0;
+}
+
 bool emu_is_empty(void)
 {
     return !core->GetMedia()->IsReady();
@@ -713,8 +936,22 @@ void emu_audio_set_lowpass_cutoff(float fc)
 
 void emu_audio_reset(void)
 {
+    core->GetAudio()->SetSampleRate(emu_audio_sample_rate());
     sound_queue_stop();
-    sound_queue_start(GLYNX_AUDIO_SAMPLE_RATE, 2, GLYNX_AUDIO_QUEUE_SIZE, config_audio.buffer_count);
+    sound_queue_start(emu_audio_sample_rate(), 2, emu_audio_queue_size(), config_audio.buffer_count);
+}
+
+int emu_audio_sample_rate(void)
+{
+    static const int sample_rates[] = { 44100, 48000, 96000 };
+    return sample_rates[CLAMP(config_audio.sample_rate, 0, 2)];
+}
+
+int emu_audio_queue_size(void)
+{
+    // Same queue duration at every rate, rounded to whole stereo frames
+    int size = (int)(((s64)GLYNX_AUDIO_QUEUE_SIZE * emu_audio_sample_rate()) / GLYNX_AUDIO_SAMPLE_RATE);
+    return MIN(size & ~1, GLYNX_AUDIO_BUFFER_SIZE);
 }
 
 bool emu_is_audio_enabled(void)
@@ -727,6 +964,31 @@ bool emu_is_audio_open(void)
     return sound_queue_is_open();
 }
 
+void emu_audio_set_dynamic_rate(bool enabled)
+{
+    sound_queue_set_dynamic_rate(enabled);
+}
+
+double emu_audio_get_rate_ratio(void)
+{
+    return sound_queue_get_rate_ratio();
+}
+
+float emu_audio_get_latency_ms(void)
+{
+    return sound_queue_get_latency_ms();
+}
+
+void emu_audio_get_queue_stats(SoundQueueStats* stats)
+{
+    sound_queue_get_stats(stats);
+}
+
+void emu_audio_reset_queue_stats(void)
+{
+    sound_queue_reset_stats();
+}
+
 void emu_save_ram(const char* file_path)
 {
     if (!emu_is_empty())
@@ -883,6 +1145,17 @@ void emu_get_info(char* info, int buffer_size)
                 break;
         }
 
+        // Where the game reads JOYSTICK/SWITCHES tells how much a late input poll would gain
+        const GLYNX_Input_Poll_Stats* input_stats = core->GetInputPollStats();
+        char input_str[64];
+        if (input_stats->polled_frames > 0)
+            snprintf(input_str, sizeof(input_str), "line %u avg (%u-%u), %u%% of frames",
+                (u32)(input_stats->line_sum / input_stats->polled_frames),
+                input_stats->min_line, input_stats->max_line,
+                (input_stats->polled_frames * 100) / input_stats->frames);
+        else
+            snprintf(input_str, sizeof(input_str), "Not read yet");
+
         snprintf(info, buffer_size,
             "File Name: %s\n"
             "CRC: %08X\n"
@@ -896,7 +1169,8 @@ void emu_get_info(char* info, int buffer_size)
             "Bank1 Page Size: %d\n"
             "Rotation: %s\n"
             "AUDIN: %s\n"
-            "EEPROM: %s%s",
+            "EEPROM: %s%s\n"
+            "Input Read: %s",
             filename, crc, is_in_database, format, rom_size, rom_size / 1024,
             runtime.screen_width, runtime.screen_height,
             header_name[0] ? header_name : "(none)",
@@ -905,7 +1179,8 @@ void emu_get_info(char* info, int buffer_size)
             rotation_str,
             audin ? "Yes" : "No",
             eeprom_str,
-            (eeprom & GLYNX_EEPROM_8BIT) ? " (8-bit)" : "");
+            (eeprom & GLYNX_EEPROM_8BIT) ? " (8-bit)" : "",
+            input_str);
     }
     else
     {
@@ -1060,6 +1335,7 @@ int emu_get_framebuffer_png(int buffer_index, unsigned char** out_buffer)
         return 0;
 
     update_debug_framebuffers();
+    complete_debug_view(Debug_View_Framebuffers);
 
     int stride = GLYNX_SCREEN_WIDTH * 4;
     int len = 0;
@@ -1168,32 +1444,76 @@ static void reset_debug(void)
         emu_debug_sprite_widths[i] = 0;
         emu_debug_sprite_heights[i] = 0;
     }
+
+    for (int i = 0; i < Debug_View_Count; i++)
+    {
+        debug_view_dirty[i] = true;
+        debug_view_last_refresh[i] = 0;
+        emu_debug_view_generation[i]++;
+    }
 }
 
 static void update_debug(void)
 {
-    if (config_debug.show_frame_buffers || config_debug.show_scb_viewer)
-        update_debug_framebuffers();
-
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
-    bool accumulate = config_debug.show_scb_viewer && config_debug.scb_viewer_mode == 1;
+    bool accumulate = (config_debug.show_scb_viewer && config_debug.scb_viewer_mode == 1) || emu_debug_sprite_profiler;
     core->GetSuzy()->SetSCBAccumulationEnabled(accumulate);
 #endif
 
-    if (config_debug.show_scb_viewer)
+    for (int i = 0; i < Debug_View_Count; i++)
+        debug_view_dirty[i] = true;
+
+    refresh_debug_views();
+}
+
+// Views are rebuilt only when the emulated state changed, a window is
+// showing them and the refresh interval elapsed. Otherwise the last
+// result stays cached, which is all a paused core ever needs.
+static void refresh_debug_views(void)
+{
+    if (is_debug_view_due(Debug_View_Framebuffers))
     {
-        if (emu_is_paused() || emu_is_debug_idle())
-        {
-            if (config_debug.scb_viewer_mode == 1)
-                update_debug_sprites_accumulated();
-            else
-                update_debug_sprites();
+        update_debug_framebuffers();
+        complete_debug_view(Debug_View_Framebuffers);
+    }
 
-            render_debug_sprites(emu_debug_scb_count);
-        }
+    if (is_debug_view_due(Debug_View_Sprites) && (emu_is_paused() || emu_is_debug_idle()))
+    {
+        if (config_debug.scb_viewer_mode == 1)
+            update_debug_sprites_accumulated();
+        else
+            update_debug_sprites();
+
+        render_debug_sprites(emu_debug_scb_count);
+        complete_debug_view(Debug_View_Sprites);
     }
 }
 
+static bool is_debug_view_due(Debug_View view)
+{
+    if (!debug_view_dirty[view])
+        return false;
+
+    if ((u32)(debug_view_frame - debug_view_seen[view]) > 1)
+        return false;
+
+    int rate = config_debug.view_refresh_rate;
+
+    if ((rate <= 0) || (debug_view_last_refresh[view] == 0))
+        return true;
+
+    Uint64 interval = SDL_GetPerformanceFrequency() / (Uint64)rate;
+
+    return (SDL_GetPerformanceCounter() - debug_view_last_refresh[view]) >= interval;
+}
+
+static void complete_debug_view(Debug_View view)
+{
+    debug_view_dirty[view] = false;
+    debug_view_last_refresh[view] = SDL_GetPerformanceCounter();
+    emu_debug_view_generation[view]++;
+}
+
 static void update_debug_framebuffers(void)
 {
     u16 vidbas = core->GetSuzy()->GetState()->VIDBAS.value;
@@ -1292,6 +1612,7 @@ static void update_debug_sprites(void)
         info.sprctl0 = sprctl0;
         info.sprctl1 = sprctl1;
         info.sprcoll = sprcoll;
+        info.has_cost = false;
 
         if (IS_SET_BIT(sprctl1, 2))
         {
@@ -1406,6 +1727,11 @@ static void update_debug_sprites_accumulated(void)
         info.sprctl1 = src.sprctl1;
         info.sprcoll = src.sprcoll;
         info.skipped = src.skipped;
+        info.has_cost = true;
+        info.cost_cycles = src.cycles;
+        info.cost_pixels = src.pixels;
+        info.cost_source_bytes = src.source_bytes;
+        info.cost_collision_accesses = src.collision_accesses;
 
         if (src.skipped)
         {
@@ -2263,6 +2589,7 @@ void emu_debug_monitor_push_frame(void)
 void emu_render_current_frame(void)
 {
     LcdScreen* lcd_screen = core->GetMikey()->GetLcdScreen();
+    emu_frame_generation++;
 
     if (!core->GetMedia()->IsBiosLoaded())
     {
@@ -22,6 +22,7 @@
 
 #include "gearlynx.h"
 #include "comlynx/comlynx_manager.h"
+#include "sound_queue.h"
 
 #ifdef EMU_IMPORT
     #define EXTERN
@@ -39,6 +40,13 @@ enum Debug_Command
     Debug_Command_None
 };
 
+enum Debug_View
+{
+    Debug_View_Framebuffers,
+    Debug_View_Sprites,
+    Debug_View_Count
+};
+
 enum Directory_Location
 {
     Directory_Location_Default = 0,
@@ -75,6 +83,11 @@ struct GLYNX_Debug_SCB_Info
     int bbox_h;
     s16 hoff;
     s16 voff;
+    bool has_cost;
+    u32 cost_cycles;
+    u32 cost_pixels;
+    u32 cost_source_bytes;
+    u32 cost_collision_accesses;
 };
 
 EXTERN u8* emu_frame_buffer;
@@ -87,11 +100,14 @@ EXTERN u32 emu_collision_palette[16];
 EXTERN int emu_debug_sprite_widths[DEBUG_MAX_SPRITES];
 EXTERN int emu_debug_sprite_heights[DEBUG_MAX_SPRITES];
 EXTERN int emu_debug_scb_count;
+EXTERN u32 emu_debug_view_generation[Debug_View_Count];
 EXTERN GLYNX_Debug_SCB_Info emu_debug_scb_info[DEBUG_MAX_SPRITES];
 EXTERN Debug_Command emu_debug_command;
 EXTERN bool emu_debug_pc_changed;
 EXTERN int emu_debug_step_frames_pending;
+EXTERN bool emu_debug_sprite_profiler;
 EXTERN u64 emu_frame_counter;
+EXTERN u32 emu_frame_generation;
 
 EXTERN bool emu_audio_sync;
 EXTERN bool emu_debug_disable_breakpoints;
@@ -100,6 +116,10 @@ EXTERN bool emu_debug_irq_breakpoints[8];
 EXTERN bool emu_init(void);
 EXTERN void emu_destroy(void);
 EXTERN void emu_update(void);
+EXTERN void emu_pump_commands(void);
+EXTERN float emu_get_speed(void);
+EXTERN void emu_set_deferred_audio(bool deferred);
+EXTERN void emu_flush_audio(void);
 EXTERN bool emu_load_rom(const char* file_path);
 EXTERN void emu_load_rom_async(const char* file_path);
 EXTERN bool emu_is_rom_loading(void);
@@ -111,6 +131,10 @@ EXTERN void emu_pause(void);
 EXTERN void emu_resume(void);
 EXTERN bool emu_is_paused(void);
 EXTERN bool emu_is_debug_idle(void);
+EXTERN bool emu_is_fast_forward_batched(void);
+EXTERN void emu_debug_views_begin_frame(void);
+EXTERN void emu_debug_view_visible(Debug_View view);
+EXTERN void emu_debug_view_invalidate(Debug_View view);
 EXTERN bool emu_is_empty(void);
 EXTERN bool emu_is_bios_loaded(void);
 EXTERN GLYNX_Bios_State emu_load_bios(const char* file_path);
@@ -127,8 +151,15 @@ EXTERN void emu_audio_set_volume(int channel, float volume);
 EXTERN void emu_audio_set_master_volume(float volume);
 EXTERN void emu_audio_set_lowpass_cutoff(float fc);
 EXTERN void emu_audio_reset(void);
+EXTERN int emu_audio_sample_rate(void);
+EXTERN int emu_audio_queue_size(void);
 EXTERN bool emu_is_audio_enabled(void);
 EXTERN bool emu_is_audio_open(void);
+EXTERN void emu_audio_set_dynamic_rate(bool enabled);
+EXTERN double emu_audio_get_rate_ratio(void);
+EXTERN float emu_audio_get_latency_ms(void);
+EXTERN void emu_audio_get_queue_stats(SoundQueueStats* stats);
+EXTERN void emu_audio_reset_queue_stats(void);
 EXTERN void emu_save_ram(const char* file_path);
 EXTERN void emu_load_ram(const char* file_path);
 EXTERN void emu_save_state_slot(int index);
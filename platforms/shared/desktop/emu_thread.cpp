@@ -0,0 +1,163 @@
+/*
+ * Gearlynx - Lynx Emulator
+ * Copyright (C) 2025  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#include <SDL3/SDL.h>
+#include "emu.h"
+#include "gearlynx.h"
+#include "utils.h"
+
+#define EMU_THREAD_IMPORT
+#include "emu_thread.h"
+
+static SDL_Thread* thread = NULL;
+static SDL_Mutex* mutex = NULL;
+static SDL_Condition* condition = NULL;
+static bool running = false;
+static bool frame_requested = false;
+
+static int thread_func(void* data);
+
+bool emu_thread_start(void)
+{
+    if (running)
+        return true;
+
+    mutex = SDL_CreateMutex();
+    condition = SDL_CreateCondition();
+
+    if (!mutex || !condition)
+    {
+        SDL_ERROR("SDL_CreateMutex/SDL_CreateCondition");
+        emu_thread_stop();
+        return false;
+    }
+
+    running = true;
+    frame_requested = false;
+    emu_set_deferred_audio(true);
+
+    thread = SDL_CreateThread(thread_func, "Gearlynx Emulation", NULL);
+
+    if (!thread)
+    {
+        SDL_ERROR("SDL_CreateThread");
+        emu_thread_stop();
+        return false;
+    }
+
+    Debug("Emulation thread started");
+    return true;
+}
+
+void emu_thread_stop(void)
+{
+    if (thread)
+    {
+        SDL_LockMutex(mutex);
+        running = false;
+        SDL_BroadcastCondition(condition);
+        SDL_UnlockMutex(mutex);
+
+        SDL_WaitThread(thread, NULL);
+        thread = NULL;
+
+        Debug("Emulation thread stopped");
+    }
+
+    running = false;
+    frame_requested = false;
+    emu_set_deferred_audio(false);
+
+    if (condition)
+    {
+        SDL_DestroyCondition(condition);
+        condition = NULL;
+    }
+
+    if (mutex)
+    {
+        SDL_DestroyMutex(mutex);
+        mutex = NULL;
+    }
+}
+
+bool emu_thread_is_running(void)
+{
+    return running;
+}
+
+void emu_thread_lock(void)
+{
+    if (!running)
+        return;
+
+    SDL_LockMutex(mutex);
+
+    while (frame_requested)
+        SDL_WaitCondition(condition, mutex);
+}
+
+void emu_thread_unlock(void)
+{
+    if (!running)
+        return;
+
+    if (frame_requested)
+        SDL_BroadcastCondition(condition);
+
+    SDL_UnlockMutex(mutex);
+}
+
+void emu_thread_request_frame(void)
+{
+    if (running)
+        frame_requested = true;
+    else
+        emu_update();
+}
+
+static int thread_func(void* data)
+{
+    UNUSED(data);
+
+    SDL_LockMutex(mutex);
+
+    while (running)
+    {
+        if (!frame_requested)
+        {
+            SDL_WaitCondition(condition, mutex);
+            continue;
+        }
+
+        emu_update();
+
+        frame_requested = false;
+        SDL_BroadcastCondition(condition);
+        SDL_UnlockMutex(mutex);
+
+        // Audio sync may block until the device drains, keep the GUI free meanwhile
+        emu_flush_audio();
+
+        SDL_LockMutex(mutex);
+    }
+
+    SDL_UnlockMutex(mutex);
+    return 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * Gearlynx - Lynx Emulator
+ * Copyright (C) 2025  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#ifndef EMU_THREAD_H
+#define EMU_THREAD_H
+
+#ifdef EMU_THREAD_IMPORT
+    #define EXTERN
+#else
+    #define EXTERN extern
+#endif
+
+EXTERN bool emu_thread_start(void);
+EXTERN void emu_thread_stop(void);
+EXTERN bool emu_thread_is_running(void);
+EXTERN void emu_thread_lock(void);
+EXTERN void emu_thread_unlock(void);
+EXTERN void emu_thread_request_frame(void);
+
+#undef EMU_THREAD_IMPORT
+#undef EXTERN
+#endif /* EMU_THREAD_H */
@@ -0,0 +1,170 @@
+/*
+ * Gearlynx - Lynx Emulator
+ * Copyright (C) 2025  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "gearlynx.h"
+#include "sound_queue.h"
+#include "utils.h"
+
+#define FRAME_PROFILER_IMPORT
+#include "frame_profiler.h"
+
+static bool enabled = false;
+static bool core_components = false;
+static FrameProfilerSample history[FRAME_PROFILER_HISTORY];
+static FrameProfilerSample current;
+static int history_head = 0;
+static int history_count = 0;
+static Uint64 last_commit = 0;
+
+static const char* const k_stage_names[FrameProfilerStage_Count] =
+{
+    "emu", "cpu", "suzy", "mikey", "audio", "lcd", "debug", "shader_gpu", "gui", "swap"
+};
+
+void frame_profiler_set_enabled(bool enable)
+{
+    if (enabled == enable)
+        return;
+
+    enabled = enable;
+    memset(&current, 0, sizeof(current));
+    last_commit = 0;
+}
+
+bool frame_profiler_is_enabled(void)
+{
+    return enabled;
+}
+
+Uint64 frame_profiler_begin(void)
+{
+    return enabled ? SDL_GetPerformanceCounter() : 0;
+}
+
+float frame_profiler_end(FrameProfilerStage stage, Uint64 start)
+{
+    if (!enabled || (start == 0))
+        return 0.0f;
+
+    float ms = (float)((double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+    current.stage_ms[stage] += ms;
+    return ms;
+}
+
+void frame_profiler_add(FrameProfilerStage stage, float ms)
+{
+    if (enabled)
+        current.stage_ms[stage] += ms;
+}
+
+// Closes the host frame that started at the previous commit
+void frame_profiler_commit(void)
+{
+    if (!enabled)
+        return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    if (last_commit != 0)
+    {
+        current.frame_ms = (float)((double)(now - last_commit) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+        current.audio_queue_ms = sound_queue_is_open() ? sound_queue_get_latency_ms() : 0.0f;
+
+        history[history_head] = current;
+        history_head = (history_head + 1) % FRAME_PROFILER_HISTORY;
+        if (history_count < FRAME_PROFILER_HISTORY)
+            history_count++;
+    }
+
+    memset(&current, 0, sizeof(current));
+    last_commit = now;
+}
+
+void frame_profiler_clear(void)
+{
+    history_head = 0;
+    history_count = 0;
+    memset(&current, 0, sizeof(current));
+    last_commit = 0;
+}
+
+int frame_profiler_get_count(void)
+{
+    return history_count;
+}
+
+const FrameProfilerSample* frame_profiler_get_sample(int index)
+{
+    if ((index < 0) || (index >= history_count))
+        return NULL;
+
+    int oldest = (history_head - history_count + FRAME_PROFILER_HISTORY) % FRAME_PROFILER_HISTORY;
+    return &history[(oldest + index) % FRAME_PROFILER_HISTORY];
+}
+
+const char* frame_profiler_get_stage_name(int stage)
+{
+    if ((stage < 0) || (stage >= FrameProfilerStage_Count))
+        return "";
+
+    return k_stage_names[stage];
+}
+
+bool frame_profiler_has_core_components(void)
+{
+    return core_components;
+}
+
+void frame_profiler_set_core_components(bool available)
+{
+    core_components = available;
+}
+
+bool frame_profiler_export_csv(const char* path)
+{
+    FILE* file = fopen_utf8(path, "w");
+
+    if (!IsValidPointer(file))
+    {
+        Log("Frame Profiler: Unable to open %s", path);
+        return false;
+    }
+
+    fprintf(file, "frame,frame_ms");
+    for (int s = 0; s < FrameProfilerStage_Count; s++)
+        fprintf(file, ",%s_ms", k_stage_names[s]);
+    fprintf(file, ",audio_queue_ms\n");
+
+    for (int i = 0; i < history_count; i++)
+    {
+        const FrameProfilerSample* sample = frame_profiler_get_sample(i);
+
+        fprintf(file, "%d,%.4f", i, sample->frame_ms);
+        for (int s = 0; s < FrameProfilerStage_Count; s++)
+            fprintf(file, ",%.4f", sample->stage_ms[s]);
+        fprintf(file, ",%.4f\n", sample->audio_queue_ms);
+    }
+
+    fclose(file);
+
+    Log("Frame Profiler: %d frames exported to %s", history_count, path);
+    return true;
+}
@@ -0,0 +1,71 @@
+/*
+ * Gearlynx - Lynx Emulator
+ * Copyright (C) 2025  Ignacio Sanchez
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ */
+
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <SDL3/SDL.h>
+
+#ifdef FRAME_PROFILER_IMPORT
+    #define EXTERN
+#else
+    #define EXTERN extern
+#endif
+
+#define FRAME_PROFILER_HISTORY 4096
+
+enum FrameProfilerStage
+{
+    FrameProfilerStage_Emu = 0,
+    FrameProfilerStage_Cpu,
+    FrameProfilerStage_Suzy,
+    FrameProfilerStage_Mikey,
+    FrameProfilerStage_Audio,
+    FrameProfilerStage_Lcd,
+    FrameProfilerStage_Debug,
+    FrameProfilerStage_Shader,
+    FrameProfilerStage_Gui,
+    FrameProfilerStage_Swap,
+    FrameProfilerStage_Count
+};
+
+struct FrameProfilerSample
+{
+    float stage_ms[FrameProfilerStage_Count];
+    float frame_ms;
+    float audio_queue_ms;
+};
+
+EXTERN void frame_profiler_set_enabled(bool enabled);
+EXTERN bool frame_profiler_is_enabled(void);
+EXTERN Uint64 frame_profiler_begin(void);
+EXTERN float frame_profiler_end(FrameProfilerStage stage, Uint64 start);
+EXTERN void frame_profiler_add(FrameProfilerStage stage, float ms);
+EXTERN void frame_profiler_commit(void);
+EXTERN void frame_profiler_clear(void);
+EXTERN int frame_profiler_get_count(void);
+EXTERN const FrameProfilerSample* frame_profiler_get_sample(int index);
+EXTERN const char* frame_profiler_get_stage_name(int stage);
+EXTERN bool frame_profiler_has_core_components(void);
+EXTERN void frame_profiler_set_core_components(bool available);
+EXTERN bool frame_profiler_export_csv(const char* path);
+
+#undef FRAME_PROFILER_IMPORT
+#undef EXTERN
+#endif /* FRAME_PROFILER_H */
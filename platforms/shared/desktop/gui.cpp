@@ -167,6 +167,9 @@ void gui_render(void)
     if (config_emulator.show_info)
         gui_show_info();
 
+    if (config_emulator.show_frame_profiler)
+        gui_show_frame_profiler();
+
     show_loading_popup();
     show_status_message();
     show_error_window();
@@ -174,6 +177,20 @@ void gui_render(void)
     ImGui::Render();
 }
 
+// True when the last rendered GUI would look the same if drawn again,
+// nothing on screen is animated or counting down
+bool gui_is_idle(void)
+{
+    if (status_message_active || loading_rom_active)
+        return false;
+    if (config_video.fps || config_emulator.show_info || config_emulator.show_frame_profiler)
+        return false;
+    if (config_emulator.ffwd)
+        return false;
+
+    return !ImGui::GetIO().WantTextInput;
+}
+
 void gui_shortcut(gui_ShortCutEvent event)
 {
     switch (event)
@@ -120,6 +120,7 @@ EXTERN bool gui_shortcut_open_rom;
 EXTERN bool gui_init(void);
 EXTERN void gui_destroy(void);
 EXTERN void gui_render(void);
+EXTERN bool gui_is_idle(void);
 EXTERN void gui_shortcut(gui_ShortCutEvent event);
 EXTERN bool gui_load_rom(const char* path, const char* symbol_path = NULL);
 EXTERN bool gui_is_rom_loading(void);
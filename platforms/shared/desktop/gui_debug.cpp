@@ -90,6 +90,8 @@ void gui_debug_windows(void)
 
     if (config_debug.debug)
     {
+        emu_debug_views_begin_frame();
+
         if (config_debug.show_processor)
             gui_debug_window_m6502();
         if (config_debug.show_memory)
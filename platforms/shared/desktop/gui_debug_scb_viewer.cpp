@@ -30,8 +30,14 @@
 #include "emu.h"
 #include "ogl_renderer.h"
 #include <cmath>
+#include <algorithm>
 
 static void draw_context_menu_sprite(int index);
+static void draw_sprite_costs(int count, int* selected_sprite);
+static bool sprite_cost_compare(int a, int b);
+
+static int cost_sort_column = 2;
+static bool cost_sort_ascending = false;
 
 static const char* k_sprite_type_names[] =
 {
@@ -51,7 +57,11 @@ void gui_debug_window_scb_viewer(void)
     ImGui::SetNextWindowPos(ImVec2(78, 56), ImGuiCond_FirstUseEver);
     ImGui::SetNextWindowSize(ImVec2(494, 464), ImGuiCond_FirstUseEver);
 
-    ImGui::Begin("SCB Viewer", &config_debug.show_scb_viewer, ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse);
+    if (ImGui::Begin("SCB Viewer", &config_debug.show_scb_viewer, ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse))
+    {
+        emu_debug_view_visible(Debug_View_Framebuffers);
+        emu_debug_view_visible(Debug_View_Sprites);
+    }
 
     GearlynxCore* core = emu_get_core();
     Suzy::Suzy_State* suzy_state = core->GetSuzy()->GetState();
@@ -62,7 +72,10 @@ void gui_debug_window_scb_viewer(void)
 
     ImGui::PushItemWidth(140.0f);
     if (ImGui::Combo("##scb_mode", &config_debug.scb_viewer_mode, "Real Time\0Accumulated\0\0"))
+    {
         selected_sprite = -1;
+        emu_debug_view_invalidate(Debug_View_Sprites);
+    }
     ImGui::PopItemWidth();
 
     if (ImGui::IsItemHovered())
@@ -82,7 +95,8 @@ void gui_debug_window_scb_viewer(void)
 
     if (config_debug.scb_viewer_mode == 0)
     {
-        ImGui::Checkbox("Auto", &config_debug.scb_viewer_auto);
+        if (ImGui::Checkbox("Auto", &config_debug.scb_viewer_auto))
+            emu_debug_view_invalidate(Debug_View_Sprites);
         ImGui::SameLine();
 
         if (config_debug.scb_viewer_auto)
@@ -107,7 +121,10 @@ void gui_debug_window_scb_viewer(void)
             ImVec2 character_size = ImGui::CalcTextSize("X");
             ImGui::PushItemWidth((6.0f * character_size.x) + (2 * ImGui::GetFrameHeight()));
             if (ImGui::InputScalar("##scb_addr", ImGuiDataType_U16, &addr, &step, &step_fast, "%04X", ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_CharsUppercase))
+            {
                 config_debug.scb_viewer_address = addr;
+                emu_debug_view_invalidate(Debug_View_Sprites);
+            }
             ImGui::PopItemWidth();
         }
 
@@ -345,6 +362,21 @@ void gui_debug_window_scb_viewer(void)
                         ImGui::TableNextColumn();
                         ImGui::TextColored(orange, " COLL DIS:"); ImGui::SameLine(); ImGui::TextColored(coll_dis ? red : gray, "%s", coll_dis ? "YES" : "NO");
 
+                        if (entry.has_cost)
+                        {
+                            ImGui::TableNextRow();
+                            ImGui::TableNextColumn();
+                            ImGui::TextColored(violet, " CYCLES:  "); ImGui::SameLine(); ImGui::Text("%u", entry.cost_cycles);
+                            ImGui::TableNextColumn();
+                            ImGui::TextColored(violet, " PIXELS:  "); ImGui::SameLine(); ImGui::Text("%u", entry.cost_pixels);
+
+                            ImGui::TableNextRow();
+                            ImGui::TableNextColumn();
+                            ImGui::TextColored(violet, " SRC BYTES:"); ImGui::SameLine(); ImGui::Text("%u", entry.cost_source_bytes);
+                            ImGui::TableNextColumn();
+                            ImGui::TextColored(violet, " COLL ACC:"); ImGui::SameLine(); ImGui::Text("%u", entry.cost_collision_accesses);
+                        }
+
                         ImGui::EndTable();
                     }
                 }
@@ -444,6 +476,10 @@ void gui_debug_window_scb_viewer(void)
                          ImVec2(fw, fh), ImVec2(0.0f, 0.0f), ImVec2(tex_u, tex_v));
         }
     }
+    else if (config_debug.scb_viewer_mode == 1)
+    {
+        draw_sprite_costs(count, &selected_sprite);
+    }
     else
     {
         ImGui::TextColored(gray, "Click a sprite to see details.");
@@ -455,6 +491,123 @@ void gui_debug_window_scb_viewer(void)
     ImGui::PopStyleVar();
 }
 
+static void draw_sprite_costs(int count, int* selected_sprite)
+{
+    static int sorted[DEBUG_MAX_SPRITES];
+
+    count = MIN(count, DEBUG_MAX_SPRITES);
+
+    u32 total_cycles = 0;
+    for (int s = 0; s < count; s++)
+        total_cycles += emu_debug_scb_info[s].cost_cycles;
+
+    ImGui::PushFont(gui_default_font);
+    ImGui::TextColored(violet, "TOTAL CYCLES:"); ImGui::SameLine();
+    ImGui::Text("%u", total_cycles);
+    ImGui::PopFont();
+
+    ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV | ImGuiTableFlags_Resizable | ImGuiTableFlags_Sortable | ImGuiTableFlags_SizingFixedFit;
+
+    if (ImGui::BeginTable("##scb_costs", 6, flags))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("#", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("SCB", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Cycles", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("Pixels", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("Bytes", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("Coll", ImGuiTableColumnFlags_WidthStretch | ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableHeadersRow();
+
+        if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs())
+        {
+            if (sort_specs->SpecsCount > 0)
+            {
+                cost_sort_column = sort_specs->Specs[0].ColumnIndex;
+                cost_sort_ascending = (sort_specs->Specs[0].SortDirection == ImGuiSortDirection_Ascending);
+            }
+            sort_specs->SpecsDirty = false;
+        }
+
+        for (int s = 0; s < count; s++)
+            sorted[s] = s;
+
+        std::stable_sort(sorted, sorted + count, sprite_cost_compare);
+
+        ImGui::PushFont(gui_default_font);
+
+        for (int i = 0; i < count; i++)
+        {
+            int s = sorted[i];
+            GLYNX_Debug_SCB_Info& entry = emu_debug_scb_info[s];
+            ImVec4 color = entry.skipped ? gray : white;
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+
+            char label[16];
+            snprintf(label, sizeof(label), "%02d##cost", s);
+            ImGui::PushStyleColor(ImGuiCol_Text, color);
+            if (ImGui::Selectable(label, *selected_sprite == s, ImGuiSelectableFlags_SpanAllColumns))
+                *selected_sprite = s;
+            ImGui::PopStyleColor();
+
+            ImGui::TableNextColumn();
+            ImGui::TextColored(cyan, "$%04X", entry.scb_address);
+            ImGui::TableNextColumn();
+            ImGui::TextColored(color, "%u", entry.cost_cycles);
+            ImGui::TableNextColumn();
+            ImGui::TextColored(color, "%u", entry.cost_pixels);
+            ImGui::TableNextColumn();
+            ImGui::TextColored(color, "%u", entry.cost_source_bytes);
+            ImGui::TableNextColumn();
+            ImGui::TextColored(color, "%u", entry.cost_collision_accesses);
+        }
+
+        ImGui::PopFont();
+
+        ImGui::EndTable();
+    }
+}
+
+static bool sprite_cost_compare(int a, int b)
+{
+    GLYNX_Debug_SCB_Info& ea = emu_debug_scb_info[a];
+    GLYNX_Debug_SCB_Info& eb = emu_debug_scb_info[b];
+    u32 va;
+    u32 vb;
+
+    switch (cost_sort_column)
+    {
+        case 1:
+            va = ea.scb_address;
+            vb = eb.scb_address;
+            break;
+        case 2:
+            va = ea.cost_cycles;
+            vb = eb.cost_cycles;
+            break;
+        case 3:
+            va = ea.cost_pixels;
+            vb = eb.cost_pixels;
+            break;
+        case 4:
+            va = ea.cost_source_bytes;
+            vb = eb.cost_source_bytes;
+            break;
+        case 5:
+            va = ea.cost_collision_accesses;
+            vb = eb.cost_collision_accesses;
+            break;
+        default:
+            va = (u32)a;
+            vb = (u32)b;
+            break;
+    }
+
+    return cost_sort_ascending ? (va < vb) : (va > vb);
+}
+
 static void draw_context_menu_sprite(int index)
 {
     char ctx_id[16];
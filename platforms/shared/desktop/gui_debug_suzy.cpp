@@ -190,7 +190,8 @@ void gui_debug_window_frame_buffers(void)
     ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 8.0f);
     ImGui::SetNextWindowPos(ImVec2(59, 70), ImGuiCond_FirstUseEver);
     ImGui::SetNextWindowSize(ImVec2(498, 426), ImGuiCond_FirstUseEver);
-    ImGui::Begin("Framebuffers", &config_debug.show_frame_buffers);
+    if (ImGui::Begin("Framebuffers", &config_debug.show_frame_buffers))
+        emu_debug_view_visible(Debug_View_Framebuffers);
 
     GearlynxCore* core = emu_get_core();
     Suzy::Suzy_State* suzy_state = core->GetSuzy()->GetState();
@@ -272,6 +273,14 @@ void gui_debug_window_frame_buffers(void)
             ImGui::Text("$%04X ", suzy_state->COLLBAS.value); ImGui::SameLine(0, 0);
             ImGui::TextColored(gray, "(" BYTE_TO_BINARY_PATTERN_SPACED " " BYTE_TO_BINARY_PATTERN_SPACED ")", BYTE_TO_BINARY(suzy_state->COLLBAS.high), BYTE_TO_BINARY(suzy_state->COLLBAS.low));
 
+            GLYNX_Runtime_Info runtime;
+            emu_get_runtime(runtime);
+            ImGui::TextColored(orange, "READS   "); ImGui::SameLine();
+            ImGui::Text("%-6u", runtime.collision_reads); ImGui::SameLine();
+            ImGui::TextColored(orange, " WRITES "); ImGui::SameLine();
+            ImGui::Text("%-6u", runtime.collision_writes); ImGui::SameLine();
+            ImGui::TextColored(gray, "(last frame)");
+
             init_collision_palette();
 
             const char* hex_labels[16] = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "A", "B", "C", "D", "E", "F"};
@@ -314,7 +323,10 @@ void gui_debug_window_frame_buffers(void)
             ImVec2 character_size = ImGui::CalcTextSize("X");
             ImGui::PushItemWidth((6.0f * character_size.x) + (2 * ImGui::GetFrameHeight()));
             if (ImGui::InputScalar("##custom_address", ImGuiDataType_U16, &custom_addr, &step, &step_fast, "%04X", ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_CharsUppercase))
+            {
                 config_debug.frame_buffer_custom_address = custom_addr;
+                emu_debug_view_invalidate(Debug_View_Framebuffers);
+            }
             ImGui::PopItemWidth();
 
             ImGui::SameLine();
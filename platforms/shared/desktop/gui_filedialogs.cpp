@@ -34,6 +34,7 @@
 #include "config.h"
 #include "emu.h"
 #include "utils.h"
+#include "frame_profiler.h"
 
 enum FileDialogID
 {
@@ -57,6 +58,7 @@ enum FileDialogID
     FileDialog_SaveDisassemblerFull,
     FileDialog_SaveDisassemblerVisible,
     FileDialog_SaveLog,
+    FileDialog_SaveFrameProfile,
     FileDialog_SaveDebugSettings,
     FileDialog_LoadDebugSettings,
     FileDialog_SaveSprite,
@@ -253,6 +255,15 @@ void gui_file_dialog_save_log(void)
     SDL_ShowSaveFileDialog(file_dialog_callback, (void*)(intptr_t)FileDialog_SaveLog, application_sdl_window, filters, 1, NULL);
 }
 
+void gui_file_dialog_save_frame_profile(void)
+{
+    if (!begin_dialog())
+        return;
+
+    SDL_DialogFileFilter filters[] = { { "CSV Files", "csv" } };
+    SDL_ShowSaveFileDialog(file_dialog_callback, (void*)(intptr_t)FileDialog_SaveFrameProfile, application_sdl_window, filters, 1, NULL);
+}
+
 void gui_file_dialog_save_debug_settings(void)
 {
     if (!begin_dialog())
@@ -456,6 +467,12 @@ static void process_dialog_result(FileDialogID id, const char* path)
             gui_debug_save_log(path);
             break;
         }
+        case FileDialog_SaveFrameProfile:
+        {
+            if (frame_profiler_export_csv(path))
+                gui_set_status_message("Frame profile exported", 3000);
+            break;
+        }
         case FileDialog_SaveDebugSettings:
         {
             gui_debug_save_settings(path);
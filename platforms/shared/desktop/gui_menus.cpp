@@ -224,6 +224,18 @@ static void menu_gearlynx(void)
             ImGui::EndMenu();
         }
 
+        ImGui::MenuItem("Emulation Thread", "", &config_emulator.emu_thread);
+
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::BeginTooltip();
+            ImGui::Text("Runs the emulation on its own thread, overlapped with drawing and presenting.");
+            ImGui::Text("Helps when buffer swaps are slow. Menus and debugger windows are still");
+            ImGui::Text("built while the emulation waits, so it does not hide debugger cost.");
+            ImGui::Text("Adds up to one frame of display latency.");
+            ImGui::EndTooltip();
+        }
+
         ImGui::Separator();
 
         bool has_save_ram = media_actions_enabled && (emu_get_core()->GetMedia()->GetSaveMemorySize() > 0);
@@ -530,6 +542,7 @@ static void menu_emulator(void)
         ImGui::Separator();
 
         ImGui::MenuItem("Show ROM info", "", &config_emulator.show_info);
+        ImGui::MenuItem("Show Frame Profiler", "", &config_emulator.show_frame_profiler);
         ImGui::MenuItem("Status Messages", "", &config_emulator.status_messages);
 
         ImGui::Separator();
@@ -727,9 +740,34 @@ static void menu_video(void)
                 ImGui::EndTooltip();
             }
 
+            ImGui::MenuItem("Auto Frame Delay", "", &config_video.frame_delay, config_video.sync_mode == config_VideoSync_Fixed);
+
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::BeginTooltip();
+                ImGui::Text("Sleeps into each refresh interval so input is read and the frame");
+                ImGui::Text("is emulated as close to the next vsync as possible.");
+                ImGui::Text("The delay tunes itself and backs off when vsyncs are missed.");
+                ImGui::Text("Not used with the emulation thread or more than one refresh per frame.");
+                ImGui::Separator();
+                ImGui::Text("Current delay: %.0f ms", display_get_frame_delay_ms());
+                ImGui::PlotHistogram("##frame_delay_slack", display_get_frame_delay_histogram(), DISPLAY_FRAME_DELAY_HISTOGRAM_SIZE, 0, "Slack (0-16 ms)", 0.0f, 1.0f, ImVec2(240.0f, 60.0f));
+                ImGui::EndTooltip();
+            }
+
             ImGui::EndMenu();
         }
 
+        ImGui::MenuItem("Idle Power Saving", "", &config_video.idle_power_save);
+
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::BeginTooltip();
+            ImGui::Text("When no game is running and there is no input,");
+            ImGui::Text("stop redrawing every frame and wait for events.");
+            ImGui::EndTooltip();
+        }
+
         ImGui::Separator();
 
         menu_shader();
@@ -1112,6 +1150,17 @@ static void menu_audio(void)
 
         ImGui::Separator();
 
+        if (ImGui::BeginMenu("Sample Rate", config_audio.enable))
+        {
+            ImGui::PushItemWidth(120.0f);
+            if (ImGui::Combo("##sample_rate", &config_audio.sample_rate, "44100 Hz\0" "48000 Hz\0" "96000 Hz\0\0"))
+            {
+                emu_audio_reset();
+            }
+            ImGui::PopItemWidth();
+            ImGui::EndMenu();
+        }
+
         if (ImGui::BeginMenu("Buffer Size", config_audio.enable))
         {
             ImGui::PushItemWidth(150.0f);
@@ -1132,6 +1181,18 @@ static void menu_audio(void)
             ImGui::EndMenu();
         }
 
+        ImGui::MenuItem("Dynamic Rate Control", "", &config_audio.dynamic_rate, config_audio.enable);
+
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::BeginTooltip();
+            ImGui::Text("Resamples audio by up to 0.5%% to keep the queue half full while");
+            ImGui::Text("the emulator is paced by vertical sync.");
+            ImGui::Text("Lets games close to the monitor refresh rate lock to vsync without");
+            ImGui::Text("audio underruns or judder.");
+            ImGui::EndTooltip();
+        }
+
 #ifndef GLYNX_DISABLE_VGMRECORDER
         ImGui::Separator();
 
@@ -1290,6 +1351,21 @@ static void menu_debug(void)
         ImGui::MenuItem("Show Framebuffers", "", &config_debug.show_frame_buffers, config_debug.debug);
         ImGui::MenuItem("Show LCD / Video DMA", "", &config_debug.show_lcd, config_debug.debug);
 
+        if (ImGui::BeginMenu("Viewer Refresh Rate", config_debug.debug))
+        {
+            ImGui::PushItemWidth(140.0f);
+            ImGui::SliderInt("##view_refresh_rate", &config_debug.view_refresh_rate, 0, 60, (config_debug.view_refresh_rate == 0) ? "Every Frame" : "%d Hz", ImGuiSliderFlags_AlwaysClamp);
+            ImGui::PopItemWidth();
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::BeginTooltip();
+                ImGui::Text("How often the Framebuffers and SCB Viewer windows are rebuilt.");
+                ImGui::Text("Hidden windows are never rebuilt. 0 refreshes every frame.");
+                ImGui::EndTooltip();
+            }
+            ImGui::EndMenu();
+        }
+
         if (ImGui::BeginMenu("Sprite Bounding Box", config_debug.debug))
         {
             static const char* k_sprite_bounding_box_modes = "Disabled\0All Sprites\0SPRCOLL Bit 7\0\0";
@@ -1503,19 +1579,26 @@ static void draw_server_status(void)
     ComLynxStatus comlynx = emu_comlynx_get_status();
     bool comlynx_active = comlynx.mode == ComLynxModeConnected;
 
-    if (!mcp_running && !debug_monitor_running && !comlynx_active)
+    bool ffwd_active = config_emulator.ffwd && !emu_is_empty();
+
+    if (!mcp_running && !debug_monitor_running && !comlynx_active && !ffwd_active)
         return;
 
+    char ffwd_status[32];
     char comlynx_status[64];
     char mcp_status[128];
     char debug_monitor_status[64];
     bool show_comlynx_status = false;
     bool show_mcp_status = false;
     bool show_debug_monitor_status = false;
+    ImVec4 ffwd_color(0.90f, 0.70f, 0.10f, 1.0f);
     ImVec4 comlynx_color(0.39f, 0.58f, 0.93f, 1.0f);
     ImVec4 mcp_color(0.10f, 0.90f, 0.10f, 1.0f);
     ImVec4 debug_monitor_color(0.20f, 0.70f, 1.0f, 1.0f);
 
+    if (ffwd_active)
+        snprintf(ffwd_status, sizeof(ffwd_status), "FFWD: x%.1f", emu_get_speed());
+
     if (comlynx.mode == ComLynxModeConnected)
     {
         snprintf(comlynx_status, sizeof(comlynx_status), "COMLYNX: S%u P%d/%d",
@@ -1549,8 +1632,14 @@ static void draw_server_status(void)
     float spacing = style.ItemSpacing.x * 2.0f;
     float text_width = 0.0f;
 
+    if (ffwd_active)
+        text_width += ImGui::CalcTextSize(ffwd_status).x;
     if (show_comlynx_status)
+    {
+        if (text_width > 0.0f)
+            text_width += spacing;
         text_width += ImGui::CalcTextSize(comlynx_status).x;
+    }
     if (show_mcp_status)
     {
         if (text_width > 0.0f)
@@ -1573,19 +1662,26 @@ static void draw_server_status(void)
     ImGui::SameLine(status_x);
     ImGui::AlignTextToFramePadding();
 
+    if (ffwd_active)
+        ImGui::TextColored(ffwd_color, "%s", ffwd_status);
+
     if (show_comlynx_status)
+    {
+        if (ffwd_active)
+            ImGui::SameLine(0.0f, spacing);
         ImGui::TextColored(comlynx_color, "%s", comlynx_status);
+    }
 
     if (show_mcp_status)
     {
-        if (show_comlynx_status)
+        if (ffwd_active || show_comlynx_status)
             ImGui::SameLine(0.0f, spacing);
         ImGui::TextColored(mcp_color, "%s", mcp_status);
     }
 
     if (show_debug_monitor_status)
     {
-        if (show_comlynx_status || show_mcp_status)
+        if (ffwd_active || show_comlynx_status || show_mcp_status)
             ImGui::SameLine(0.0f, spacing);
         ImGui::TextColored(debug_monitor_color, "%s", debug_monitor_status);
     }
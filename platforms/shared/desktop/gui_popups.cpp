@@ -22,6 +22,7 @@
 #define GUI_POPUPS_IMPORT
 #include "gui_popups.h"
 #include "gui.h"
+#include "gui_filedialogs.h"
 #include "gui_debug_constants.h"
 #include "config.h"
 #include "application.h"
@@ -31,6 +32,7 @@
 #include "backers.h"
 #include "ogl_renderer.h"
 #include "keyboard.h"
+#include "frame_profiler.h"
 #include "imgui.h"
 #include "implot.h"
 
@@ -377,8 +379,8 @@ void gui_show_info(void)
     ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 8.0f);
     ImGui::Begin("ROM Info", &config_emulator.show_info, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoResize);
 
-    static char info[512] = "";
-    emu_get_info(info, 512);
+    static char info[1024] = "";
+    emu_get_info(info, sizeof(info));
 
     ImGui::PushFont(gui_default_font);
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f,0.502f,0.957f,1.0f));
@@ -391,12 +393,108 @@ void gui_show_info(void)
     ImGui::PopStyleVar();
 }
 
+void gui_show_frame_profiler(void)
+{
+    static const int k_plot_frames = 300;
+    static float xs[k_plot_frames];
+    static float stacks[FrameProfilerStage_Count + 1][k_plot_frames];
+
+    ImGui::SetNextWindowSize(ImVec2(560.0f, 470.0f), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Frame Profiler", &config_emulator.show_frame_profiler);
+
+    int count = frame_profiler_get_count();
+    int plot_count = MIN(count, k_plot_frames);
+    int first = count - plot_count;
+
+    for (int i = 0; i < plot_count; i++)
+    {
+        const FrameProfilerSample* sample = frame_profiler_get_sample(first + i);
+        xs[i] = (float)i;
+        stacks[0][i] = 0.0f;
+        for (int s = 0; s < FrameProfilerStage_Count; s++)
+            stacks[s + 1][i] = stacks[s][i] + sample->stage_ms[s];
+    }
+
+    if (ImPlot::BeginPlot("##frame_profiler", ImVec2(-1.0f, 200.0f), ImPlotFlags_NoMenus | ImPlotFlags_NoBoxSelect))
+    {
+        ImPlot::SetupAxes(NULL, "ms", ImPlotAxisFlags_NoTickLabels, ImPlotAxisFlags_AutoFit);
+        ImPlot::SetupAxisLimits(ImAxis_X1, 0.0, (double)k_plot_frames, ImPlotCond_Always);
+        ImPlot::SetupLegend(ImPlotLocation_NorthWest, ImPlotLegendFlags_Outside);
+
+        for (int s = 0; s < FrameProfilerStage_Count; s++)
+            ImPlot::PlotShaded(frame_profiler_get_stage_name(s), xs, stacks[s], stacks[s + 1], plot_count);
+
+        double budget = 1000.0 / 60.0;
+        ImPlot::PlotInfLines("16.7 ms", &budget, 1, ImPlotInfLinesFlags_Horizontal);
+        ImPlot::EndPlot();
+    }
+
+    float sum[FrameProfilerStage_Count + 2] = { };
+    float peak[FrameProfilerStage_Count + 2] = { };
+
+    for (int i = 0; i < count; i++)
+    {
+        const FrameProfilerSample* sample = frame_profiler_get_sample(i);
+        for (int s = 0; s < FrameProfilerStage_Count + 2; s++)
+        {
+            float value = (s < FrameProfilerStage_Count) ? sample->stage_ms[s] : ((s == FrameProfilerStage_Count) ? sample->frame_ms : sample->audio_queue_ms);
+            sum[s] += value;
+            peak[s] = MAX(peak[s], value);
+        }
+    }
+
+    if (ImGui::BeginTable("##frame_profiler_stages", 3, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+    {
+        ImGui::TableSetupColumn("Stage", ImGuiTableColumnFlags_WidthFixed, 140.0f);
+        ImGui::TableSetupColumn("Avg (ms)", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+        ImGui::TableSetupColumn("Max (ms)", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+        ImGui::TableHeadersRow();
+
+        for (int s = 0; s < FrameProfilerStage_Count + 2; s++)
+        {
+            const char* name = (s < FrameProfilerStage_Count) ? frame_profiler_get_stage_name(s) : ((s == FrameProfilerStage_Count) ? "frame" : "audio queue");
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", (count > 0) ? sum[s] / count : 0.0f);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", peak[s]);
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::Text("%d / %d frames", count, FRAME_PROFILER_HISTORY);
+
+    if (!frame_profiler_has_core_components())
+        ImGui::TextDisabled("CPU, Suzy, Mikey and audio need a build with PROFILE=1");
+
+    if (ImGui::Button("Clear"))
+        frame_profiler_clear();
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Export CSV..."))
+        gui_file_dialog_save_frame_profile();
+
+    ImGui::End();
+}
+
 void gui_show_fps(void)
 {
     ImGui::PushFont(gui_default_font);
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f,1.00f,0.0f,1.0f));
     ImGui::SetCursorPos(ImVec2(5.0f, config_debug.debug ? 25.0f : 5.0f));
     ImGui::Text("FPS:  %.2f\nTIME: %.2f ms", ImGui::GetIO().Framerate, 1000.0f / ImGui::GetIO().Framerate);
+    if (emu_is_audio_open())
+    {
+        SoundQueueStats stats;
+        emu_audio_get_queue_stats(&stats);
+        int fill = (stats.target_samples > 0) ? (stats.fill_samples * 100) / stats.target_samples : 0;
+        ImGui::Text("LAT:  %.1f ms\nRATE: %.4f", stats.latency_ms, stats.rate_ratio);
+        ImGui::Text("FILL: %d%%\nUND:  %u\nOVR:  %u", fill, stats.underruns, stats.overruns);
+    }
     ImGui::PopStyleColor();
     ImGui::PopFont();
 }
@@ -34,6 +34,7 @@ EXTERN void gui_popup_modal_load_defaults(void);
 EXTERN void gui_popup_modal_bios(void);
 EXTERN void gui_show_info(void);
 EXTERN void gui_show_fps(void);
+EXTERN void gui_show_frame_profiler(void);
 
 #undef GUI_POPUPS_IMPORT
 #undef EXTERN
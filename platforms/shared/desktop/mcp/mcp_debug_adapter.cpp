@@ -22,6 +22,7 @@
 #include "log.h"
 #include "../utils.h"
 #include "../emu.h"
+#include "../frame_profiler.h"
 #include "../gui.h"
 #include "../gui_actions.h"
 #include "../gui_debug_disassembler.h"
@@ -1429,6 +1430,81 @@ json DebugAdapter::ResetComLynxMetrics()
     return {{"success", true}};
 }
 
+json DebugAdapter::GetAudioQueueStatus(bool reset)
+{
+    SoundQueueStats stats;
+    emu_audio_get_queue_stats(&stats);
+
+    json status;
+    status["open"] = stats.open;
+    status["fill_samples"] = stats.fill_samples;
+    status["target_samples"] = stats.target_samples;
+    status["fill_percent"] = (stats.target_samples > 0) ? (stats.fill_samples * 100.0) / stats.target_samples : 0.0;
+    status["latency_ms"] = stats.latency_ms;
+    status["rate_ratio"] = stats.rate_ratio;
+    status["underruns"] = stats.underruns;
+    status["overruns"] = stats.overruns;
+
+    if (reset)
+        emu_audio_reset_queue_stats();
+
+    return status;
+}
+
+json DebugAdapter::GetFrameProfile(int enable, int frames, const std::string& csv_path)
+{
+    if (enable >= 0)
+        config_emulator.show_frame_profiler = (enable != 0);
+
+    int count = frame_profiler_get_count();
+    int summarized = (frames > 0) ? MIN(frames, count) : count;
+    int first = count - summarized;
+
+    json result;
+    result["enabled"] = config_emulator.show_frame_profiler;
+    result["recorded_frames"] = count;
+    result["summarized_frames"] = summarized;
+    result["core_components"] = frame_profiler_has_core_components();
+
+    json stages = json::object();
+
+    for (int s = 0; s < FrameProfilerStage_Count + 2; s++)
+    {
+        double sum = 0.0;
+        double peak = 0.0;
+
+        for (int i = first; i < count; i++)
+        {
+            const FrameProfilerSample* sample = frame_profiler_get_sample(i);
+            double value = (s < FrameProfilerStage_Count) ? sample->stage_ms[s] : ((s == FrameProfilerStage_Count) ? sample->frame_ms : sample->audio_queue_ms);
+            sum += value;
+            peak = MAX(peak, value);
+        }
+
+        json stage;
+        stage["avg_ms"] = (summarized > 0) ? sum / summarized : 0.0;
+        stage["max_ms"] = peak;
+
+        if (s < FrameProfilerStage_Count)
+            stages[frame_profiler_get_stage_name(s)] = stage;
+        else if (s == FrameProfilerStage_Count)
+            result["frame"] = stage;
+        else
+            result["audio_queue"] = stage;
+    }
+
+    result["stages"] = stages;
+
+    if (!csv_path.empty())
+    {
+        bool exported = frame_profiler_export_csv(csv_path.c_str());
+        result["csv_exported"] = exported;
+        result["csv_path"] = csv_path;
+    }
+
+    return result;
+}
+
 static const char* get_eeprom_type_name(GLYNX_EEPROM type)
 {
     s32 base_type = type & 0x0F;
@@ -1765,6 +1841,171 @@ json DebugAdapter::GetSprite(int index, const std::string& format)
     return result;
 }
 
+json DebugAdapter::GetSpriteCosts(int count, bool profiling)
+{
+    json result;
+
+    if (!m_core || !m_core->GetMedia()->IsReady())
+    {
+        result["error"] = "No media loaded";
+        return result;
+    }
+
+    Suzy* suzy = m_core->GetSuzy();
+
+    if (!profiling)
+    {
+        emu_debug_sprite_profiler = false;
+        suzy->SetSCBAccumulationEnabled(config_debug.show_scb_viewer && config_debug.scb_viewer_mode == 1);
+        result["profiling"] = false;
+        return result;
+    }
+
+    result["profiling"] = true;
+
+    if (!emu_debug_sprite_profiler)
+    {
+        emu_debug_sprite_profiler = true;
+        suzy->SetSCBAccumulationEnabled(true);
+        result["frame_sprites"] = 0;
+        result["total_cycles"] = 0;
+        result["sprites"] = json::array();
+        result["message"] = "Sprite profiling enabled. Run at least one frame and call again.";
+        return result;
+    }
+
+    std::vector<Suzy::GLYNX_SCB_Info>* frame_list = suzy->GetFrameSCBList();
+    int size = (int)frame_list->size();
+
+    std::vector<int> order(size);
+    u32 total_cycles = 0;
+    for (int i = 0; i < size; i++)
+    {
+        order[i] = i;
+        total_cycles += (*frame_list)[i].cycles;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [frame_list](int a, int b) {
+        return (*frame_list)[a].cycles > (*frame_list)[b].cycles;
+    });
+
+    count = CLAMP(count, 1, 256);
+    int returned = MIN(count, size);
+
+    json sprites = json::array();
+    std::ostringstream ss;
+    ss << std::hex << std::uppercase << std::setfill('0');
+
+    for (int i = 0; i < returned; i++)
+    {
+        Suzy::GLYNX_SCB_Info& info = (*frame_list)[order[i]];
+        json sprite;
+
+        sprite["scb_index"] = order[i];
+        ss << std::setw(4) << info.scb_address;
+        sprite["scb_address"] = ss.str(); ss.str("");
+        sprite["skipped"] = info.skipped;
+        sprite["hpos"] = info.hpos;
+        sprite["vpos"] = info.vpos;
+        sprite["cycles"] = info.cycles;
+        sprite["pixels"] = info.pixels;
+        sprite["source_bytes"] = info.source_bytes;
+        sprite["collision_accesses"] = info.collision_accesses;
+        sprites.push_back(sprite);
+    }
+
+    result["frame_sprites"] = size;
+    result["total_cycles"] = total_cycles;
+    result["sprites"] = sprites;
+
+    return result;
+}
+
+json DebugAdapter::ValidateSprites(bool enabled, bool clear, int count)
+{
+    json result;
+
+    if (!m_core || !m_core->GetMedia()->IsReady())
+    {
+        result["error"] = "No media loaded";
+        return result;
+    }
+
+    Suzy* suzy = m_core->GetSuzy();
+    suzy->SetSpriteValidation(enabled);
+
+    if (clear)
+        suzy->ClearSpriteValidation();
+
+    result["enabled"] = enabled;
+    result["legacy_sprite_renderer"] = config_emulator.fast_sprite_rendering;
+
+    if (enabled && !config_emulator.fast_sprite_rendering)
+        result["message"] = "Validation only runs while the legacy sprite renderer is enabled.";
+
+    std::vector<Suzy::GLYNX_Sprite_Validation_Mismatch>* list = suzy->GetSpriteValidationMismatches();
+
+    count = CLAMP(count, 1, 1024);
+    int returned = MIN(count, (int)list->size());
+
+    json mismatches = json::array();
+    std::ostringstream ss;
+    ss << std::hex << std::uppercase << std::setfill('0');
+
+    for (int i = 0; i < returned; i++)
+    {
+        Suzy::GLYNX_Sprite_Validation_Mismatch& m = (*list)[i];
+        json mismatch;
+
+        mismatch["frame"] = m.frame;
+        ss << std::setw(4) << m.scb_address;
+        mismatch["scb_address"] = ss.str(); ss.str("");
+
+        mismatch["type"] = m.collision_buffer ? "collision" : "pixel";
+        ss << std::setw(4) << m.address;
+        mismatch["address"] = ss.str(); ss.str("");
+        if (m.x >= 0)
+        {
+            mismatch["x"] = m.x;
+            mismatch["y"] = m.y;
+        }
+        ss << std::setw(2) << (int)m.fast_value;
+        mismatch["fast_value"] = ss.str(); ss.str("");
+        ss << std::setw(2) << (int)m.accurate_value;
+        mismatch["accurate_value"] = ss.str(); ss.str("");
+
+        mismatches.push_back(mismatch);
+    }
+
+    std::vector<Suzy::GLYNX_Sprite_Validation_Mismatch>* reports = suzy->GetSpriteValidationCycleReports();
+    returned = MIN(count, (int)reports->size());
+
+    json cycle_reports = json::array();
+
+    for (int i = 0; i < returned; i++)
+    {
+        Suzy::GLYNX_Sprite_Validation_Mismatch& m = (*reports)[i];
+        json report;
+
+        report["frame"] = m.frame;
+        ss << std::setw(4) << m.scb_address;
+        report["scb_address"] = ss.str(); ss.str("");
+        report["fast_cycles"] = m.fast_cycles;
+        report["accurate_cycles"] = m.accurate_cycles;
+
+        cycle_reports.push_back(report);
+    }
+
+    result["frames"] = suzy->GetSpriteValidationFrames();
+    result["sprite_runs"] = suzy->GetSpriteValidationRuns();
+    result["mismatch_count"] = suzy->GetSpriteValidationMismatchCount();
+    result["mismatches"] = mismatches;
+    result["cycle_report_count"] = suzy->GetSpriteValidationCycleReportCount();
+    result["cycle_reports"] = cycle_reports;
+
+    return result;
+}
+
 json DebugAdapter::StartLoadMedia(const std::string& file_path)
 {
     json result;
@@ -115,11 +115,15 @@ public:
     json WriteSuzyRegister(u16 address, u8 value);
     json GetUARTStatus();
     json ResetComLynxMetrics();
+    json GetAudioQueueStatus(bool reset);
+    json GetFrameProfile(int enable, int frames, const std::string& csv_path);
     json GetCartStatus();
     json GetEepromStatus();
     json GetScreenshot();
     json GetFrameBuffer(const std::string& buffer_type);
     json GetSprite(int index, const std::string& format);
+    json GetSpriteCosts(int count, bool profiling);
+    json ValidateSprites(bool enabled, bool clear, int count);
 
     // Media and state management
     json GetMediaInfo();
@@ -867,6 +867,48 @@ json McpServer::BuildToolList()
         }}
     });
 
+    tools.push_back({
+        {"name", "get_audio_queue_status"},
+        {"title", "Get Audio Queue Status"},
+        {"description", "Read host audio queue fill level, latency, rate ratio, underruns and overruns."},
+        {"annotations", {{"readOnlyHint", false}, {"destructiveHint", false}, {"idempotentHint", false}, {"openWorldHint", false}}},
+        {"inputSchema", {
+            {"type", "object"},
+            {"properties", {
+                {"reset", {
+                    {"type", "boolean"},
+                    {"description", "Reset the underrun and overrun counters after reading. Default false."}
+                }}
+            }}
+        }}
+    });
+
+    tools.push_back({
+        {"name", "get_frame_profile"},
+        {"title", "Get Frame Profile"},
+        {"description", "Read host frame timing per stage (emulation, core components, debugger, LCD, GPU shaders, GUI, swap) and audio queue depth, optionally enabling the profiler or exporting CSV."},
+        {"annotations", {{"readOnlyHint", false}, {"destructiveHint", false}, {"idempotentHint", false}, {"openWorldHint", false}}},
+        {"inputSchema", {
+            {"type", "object"},
+            {"properties", {
+                {"enable", {
+                    {"type", "boolean"},
+                    {"description", "Optional. Turn the profiler on or off; omit to leave it as is."}
+                }},
+                {"frames", {
+                    {"type", "integer"},
+                    {"description", "Number of most recent frames to summarize. Default all recorded."},
+                    {"minimum", 1},
+                    {"maximum", 4096}
+                }},
+                {"csv_path", {
+                    {"type", "string"},
+                    {"description", "Optional file path to export every recorded frame as CSV."}
+                }}
+            }}
+        }}
+    });
+
     tools.push_back({
         {"name", "get_cart_status"},
         {"title", "Get Cartridge Status"},
@@ -951,6 +993,56 @@ json McpServer::BuildToolList()
         }}
     });
 
+    tools.push_back({
+        {"name", "get_sprite_costs"},
+        {"title", "Get Sprite Costs"},
+        {"description", "Profile Suzy sprite cost: top-N costliest SCBs of the last frame by blitter cycles, with pixels written, source bytes read and collision buffer accesses. First call enables profiling; run a frame and call again."},
+        {"annotations", {{"readOnlyHint", false}, {"destructiveHint", false}, {"idempotentHint", true}, {"openWorldHint", false}}},
+        {"inputSchema", {
+            {"type", "object"},
+            {"properties", {
+                {"count", {
+                    {"type", "integer"},
+                    {"description", "Sprites to return, costliest first (default 10, max 256)"},
+                    {"minimum", 1},
+                    {"maximum", 256}
+                }},
+                {"profiling", {
+                    {"type", "boolean"},
+                    {"description", "Keep profiling enabled (default true). Pass false to stop profiling."}
+                }}
+            }},
+            {"additionalProperties", false}
+        }}
+    });
+
+    tools.push_back({
+        {"name", "validate_sprites"},
+        {"title", "Validate Sprites"},
+        {"description", "Validate the legacy (fast) sprite renderer against the accurate one: every SPRGO is replayed through the accurate blitter on a scratch copy of RAM and pixel differences are reported with frame, SCB address and first differing pixel. SCBs whose fast cycle estimate is off by more than 50% (and 64 cycles) are listed separately as cycle reports. Only runs while Legacy Sprite Renderer is enabled."},
+        {"annotations", {{"readOnlyHint", false}, {"destructiveHint", false}, {"idempotentHint", true}, {"openWorldHint", false}}},
+        {"inputSchema", {
+            {"type", "object"},
+            {"properties", {
+                {"enabled", {
+                    {"type", "boolean"},
+                    {"description", "Keep validation enabled (default true). Pass false to stop validating."}
+                }},
+                {"clear", {
+                    {"type", "boolean"},
+                    {"description", "Clear collected results before returning (default false)"}
+                }},
+                {"count", {
+                    {"type", "integer"},
+                    {"description", "Mismatches and cycle reports to return, oldest first (default 20, max 1024)"},
+                    {"minimum", 1},
+                    {"maximum", 1024}
+                }}
+            }},
+            {"additionalProperties", false}
+        }}
+    });
+
     // Media and state management tools
     tools.push_back({
         {"name", "load_media"},
@@ -2516,6 +2608,18 @@ json McpServer::ExecuteCommand(const std::string& toolName, const json& argument
     {
         return m_debugAdapter.ResetComLynxMetrics();
     }
+    else if (normalizedTool == "get_frame_profile")
+    {
+        int enable = arguments.contains("enable") ? (arguments["enable"].get<bool>() ? 1 : 0) : -1;
+        int frames = arguments.value("frames", 0);
+        std::string csv_path = arguments.value("csv_path", std::string());
+        return m_debugAdapter.GetFrameProfile(enable, frames, csv_path);
+    }
+    else if (normalizedTool == "get_audio_queue_status")
+    {
+        bool reset = arguments.value("reset", false);
+        return m_debugAdapter.GetAudioQueueStatus(reset);
+    }
     else if (normalizedTool == "get_cart_status")
     {
         return m_debugAdapter.GetCartStatus();
@@ -2543,6 +2647,19 @@ json McpServer::ExecuteCommand(const std::string& toolName, const json& argument
         std::string format = arguments["format"];
         return m_debugAdapter.GetSprite(index, format);
     }
+    else if (normalizedTool == "get_sprite_costs")
+    {
+        int count = arguments.value("count", 10);
+        bool profiling = arguments.value("profiling", true);
+        return m_debugAdapter.GetSpriteCosts(count, profiling);
+    }
+    else if (normalizedTool == "validate_sprites")
+    {
+        bool enabled = arguments.value("enabled", true);
+        bool clear = arguments.value("clear", false);
+        int count = arguments.value("count", 20);
+        return m_debugAdapter.ValidateSprites(enabled, clear, count);
+    }
     // Media and state management
     else if (normalizedTool == "load_media")
     {
@@ -262,7 +262,7 @@ static const char* const kMcpMikeyTools[] =
 
 static const char* const kMcpSuzyTools[] =
 {
-    "get_suzy_registers", "write_suzy_register", "get_sprite"
+    "get_suzy_registers", "write_suzy_register", "get_sprite", "get_sprite_costs", "validate_sprites"
 };
 
 static const char* const kMcpLcdTools[] =
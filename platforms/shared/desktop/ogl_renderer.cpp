@@ -36,6 +36,7 @@
 #include "ogl_renderer.h"
 #include "ogl_shader_chain.h"
 #include "ogl_shader_program.h"
+#include "frame_profiler.h"
 
 static uint32_t system_texture;
 static uint32_t frame_buffer_object;
@@ -43,6 +44,35 @@ static GLYNX_Runtime_Info current_runtime;
 static OglRendererScreenGeometry screen_geometry;
 static int savestates_texture_slot = -1;
 static u32 savestates_texture_generation = 0;
+static u32 debug_textures_generation[Debug_View_Count];
+static u32 last_system_frame_generation = 0;
+static int last_system_frame_width = 0;
+static int last_system_frame_height = 0;
+static bool emu_texture_valid = false;
+
+#define PBO_RING_SIZE 3
+#define PBO_ALIGNMENT 256
+#define PBO_MIN_CAPACITY (256 * 1024)
+#define PBO_MAX_CAPACITY (4 * 1024 * 1024)
+
+struct PboSlot
+{
+    uint32_t buffer;
+    size_t capacity;
+    size_t offset;
+    GLsync fence;
+};
+
+static PboSlot pbo_ring[PBO_RING_SIZE];
+static int pbo_ring_index = 0;
+static bool pbo_enabled = false;
+
+#define GPU_TIMER_QUERY_COUNT 4
+
+static uint32_t gpu_timer_queries[GPU_TIMER_QUERY_COUNT];
+static bool gpu_timer_pending[GPU_TIMER_QUERY_COUNT];
+static int gpu_timer_index = 0;
+static bool gpu_timer_supported = false;
 
 static uint32_t quad_shader_program = 0;
 static uint32_t quad_vao = 0;
@@ -65,7 +95,17 @@ static void render_emu_normal(void);
 static void bind_texture_unit(int unit, uint32_t texture, uint32_t fallback_texture);
 static void render_quad(uint32_t program, uint32_t texture, int viewport_width, int viewport_height, float tex_h, float tex_v, float red, float green, float blue, float alpha);
 static void render_quad_preset(int pass_index, uint32_t program, uint32_t texture, int input_width, int input_height, int viewport_width, int viewport_height);
+static void init_ogl_pbo(void);
+static void destroy_ogl_pbo(void);
+static void begin_pbo_frame(void);
+static void end_pbo_frame(void);
+static void upload_texture(uint32_t texture, int width, int height, int row_length, const void* pixels);
+static void init_gpu_timer(void);
+static void destroy_gpu_timer(void);
+static bool begin_gpu_timer(void);
+static void end_gpu_timer(void);
 static void update_system_texture(void);
+static bool is_system_frame_unchanged(void);
 static void update_debug_textures(void);
 static void update_savestates_texture(void);
 static void load_configured_shader_preset(void);
@@ -111,12 +151,16 @@ bool ogl_renderer_init(void)
 
     init_ogl_debug();
     init_ogl_savestates();
+    init_ogl_pbo();
+    init_gpu_timer();
 
     return true;
 }
 
 void ogl_renderer_destroy(void)
 {
+    destroy_ogl_pbo();
+    destroy_gpu_timer();
     glDeleteFramebuffers(1, &frame_buffer_object); 
     glDeleteTextures(1, &ogl_renderer_emu_texture);
     glDeleteTextures(1, &system_texture);
@@ -153,6 +197,9 @@ void ogl_renderer_render(void)
 {
     emu_get_runtime(current_runtime);
 
+    begin_pbo_frame();
+    bool gpu_timer = begin_gpu_timer();
+
     if (config_debug.debug)
     {
         update_debug_textures();
@@ -163,10 +210,33 @@ void ogl_renderer_render(void)
     bool use_internal_shader_chain = should_use_internal_shader_chain();
 
     if (use_internal_shader_chain)
+    {
+        emu_texture_valid = false;
         render_internal_shader_chain();
-    else
+    }
+    else if (!is_system_frame_unchanged())
         render_emu_normal();
 
+    if (gpu_timer)
+        end_gpu_timer();
+
+    end_pbo_frame();
+}
+
+bool ogl_renderer_is_frame_unchanged(void)
+{
+    GLYNX_Runtime_Info runtime;
+    emu_get_runtime(runtime);
+
+    return !should_use_internal_shader_chain() &&
+            emu_texture_valid &&
+            (runtime.screen_width == last_system_frame_width) &&
+            (runtime.screen_height == last_system_frame_height) &&
+            (emu_frame_generation == last_system_frame_generation);
+}
+
+void ogl_renderer_render_gui(void)
+{
     ImVec4 clear_color = ImVec4(config_video.background_color[config_emulator.theme][0], config_video.background_color[config_emulator.theme][1], config_video.background_color[config_emulator.theme][2], 1.00f);
 
     ImGuiIO& io = ImGui::GetIO();
@@ -295,6 +365,7 @@ static void init_ogl_gui(void)
 
 static bool init_ogl_emu(void)
 {
+    emu_texture_valid = false;
     glGenFramebuffers(1, &frame_buffer_object);
     create_texture_2d(&ogl_renderer_emu_texture, FRAME_BUFFER_WIDTH, FRAME_BUFFER_HEIGHT, GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE, NULL, false);
     create_texture_2d(&system_texture, SYSTEM_TEXTURE_WIDTH, SYSTEM_TEXTURE_HEIGHT, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*) emu_frame_buffer, false);
@@ -320,6 +391,9 @@ static void init_ogl_debug(void)
     {
         create_texture_2d(&ogl_renderer_emu_debug_framebuffer[s], 256, 128, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*)emu_debug_framebuffer[s], false);
     }
+
+    for (int v = 0; v < Debug_View_Count; v++)
+        debug_textures_generation[v] = emu_debug_view_generation[v];
 }
 
 static void init_ogl_savestates(void)
@@ -329,6 +403,235 @@ static void init_ogl_savestates(void)
     savestates_texture_generation = 0;
 }
 
+static void init_ogl_pbo(void)
+{
+#if defined(__APPLE__)
+    pbo_enabled = true;
+#else
+    pbo_enabled = (GLAD_GL_VERSION_3_2 != 0);
+#endif
+
+    pbo_ring_index = 0;
+
+    for (int i = 0; i < PBO_RING_SIZE; i++)
+    {
+        pbo_ring[i].buffer = 0;
+        pbo_ring[i].capacity = 0;
+        pbo_ring[i].offset = 0;
+        pbo_ring[i].fence = 0;
+
+        if (pbo_enabled)
+            glGenBuffers(1, &pbo_ring[i].buffer);
+    }
+
+    if (!pbo_enabled)
+        Log("Pixel buffer objects not available, using synchronous texture uploads");
+}
+
+static void destroy_ogl_pbo(void)
+{
+    for (int i = 0; i < PBO_RING_SIZE; i++)
+    {
+        if (pbo_ring[i].fence)
+            glDeleteSync(pbo_ring[i].fence);
+        if (pbo_ring[i].buffer)
+            glDeleteBuffers(1, &pbo_ring[i].buffer);
+
+        pbo_ring[i].buffer = 0;
+        pbo_ring[i].capacity = 0;
+        pbo_ring[i].fence = 0;
+    }
+
+    pbo_enabled = false;
+}
+
+// Every host frame streams its uploads through one slot of the ring.
+// If the GPU is still reading that slot from PBO_RING_SIZE frames ago
+// the storage is orphaned instead of waiting on the fence. A slot that
+// used less than a quarter of its storage last time is halved, so a
+// burst of debugger uploads does not keep the memory around.
+static void begin_pbo_frame(void)
+{
+    if (!pbo_enabled)
+        return;
+
+    PboSlot* slot = &pbo_ring[pbo_ring_index];
+    size_t used = slot->offset;
+    bool busy = false;
+    slot->offset = 0;
+
+    if (slot->fence)
+    {
+        GLenum result = glClientWaitSync(slot->fence, 0, 0);
+        glDeleteSync(slot->fence);
+        slot->fence = 0;
+        busy = (result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED);
+    }
+
+    size_t capacity = slot->capacity;
+
+    if ((capacity > PBO_MIN_CAPACITY) && (used < capacity / 4))
+        capacity = MAX(capacity / 2, (size_t)PBO_MIN_CAPACITY);
+
+    if (busy || (capacity != slot->capacity))
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->buffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)capacity, NULL, GL_STREAM_DRAW);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        slot->capacity = capacity;
+    }
+}
+
+static void end_pbo_frame(void)
+{
+    if (!pbo_enabled)
+        return;
+
+    PboSlot* slot = &pbo_ring[pbo_ring_index];
+
+    if (slot->offset == 0)
+        return;
+
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    pbo_ring_index = (pbo_ring_index + 1) % PBO_RING_SIZE;
+}
+
+// Uploads the width x height top-left corner of a source image whose rows
+// are row_length pixels apart. The PBO copy is always tightly packed.
+static void upload_texture(uint32_t texture, int width, int height, int row_length, const void* pixels)
+{
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    PboSlot* slot = &pbo_ring[pbo_ring_index];
+    size_t size = (size_t)width * (size_t)height * 4;
+
+    if (!pbo_enabled || (slot->offset + size > PBO_MAX_CAPACITY))
+    {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, (row_length != width) ? row_length : 0);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (const GLvoid*) pixels);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        return;
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->buffer);
+
+    if (slot->offset + size > slot->capacity)
+    {
+        // Fresh storage, commands already issued keep reading the old one
+        size_t capacity = MAX(slot->capacity * 2, (size_t)PBO_MIN_CAPACITY);
+        if (capacity < slot->offset + size)
+            capacity = slot->offset + size;
+        capacity = MIN(capacity, (size_t)PBO_MAX_CAPACITY);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)capacity, NULL, GL_STREAM_DRAW);
+        slot->capacity = capacity;
+    }
+
+    void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, (GLintptr)slot->offset, (GLsizeiptr)size,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+    if (!IsValidPointer(dst))
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, (row_length != width) ? row_length : 0);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (const GLvoid*) pixels);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        return;
+    }
+
+    if (row_length == width)
+        memcpy(dst, pixels, size);
+    else
+    {
+        size_t line_size = (size_t)width * 4;
+        size_t source_pitch = (size_t)row_length * 4;
+        for (int y = 0; y < height; y++)
+            memcpy((u8*)dst + (y * line_size), (const u8*)pixels + (y * source_pitch), line_size);
+    }
+
+    if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE)
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (const GLvoid*)(uintptr_t) slot->offset);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    slot->offset += (size + PBO_ALIGNMENT - 1) & ~((size_t)PBO_ALIGNMENT - 1);
+}
+
+static void init_gpu_timer(void)
+{
+#if defined(__APPLE__)
+    #if defined(GL_TIME_ELAPSED)
+    gpu_timer_supported = true;
+    #else
+    gpu_timer_supported = false;
+    #endif
+#else
+    gpu_timer_supported = (GLAD_GL_VERSION_3_3 != 0);
+#endif
+
+    gpu_timer_index = 0;
+
+    for (int i = 0; i < GPU_TIMER_QUERY_COUNT; i++)
+    {
+        gpu_timer_queries[i] = 0;
+        gpu_timer_pending[i] = false;
+    }
+
+    if (gpu_timer_supported)
+        glGenQueries(GPU_TIMER_QUERY_COUNT, gpu_timer_queries);
+}
+
+static void destroy_gpu_timer(void)
+{
+    if (gpu_timer_supported)
+        glDeleteQueries(GPU_TIMER_QUERY_COUNT, gpu_timer_queries);
+
+    gpu_timer_supported = false;
+}
+
+// Results are picked up a few frames later, whenever the GPU has them,
+// so the profiler never waits on the GPU
+static bool begin_gpu_timer(void)
+{
+#if defined(GL_TIME_ELAPSED)
+    if (!gpu_timer_supported)
+        return false;
+
+    for (int i = 0; i < GPU_TIMER_QUERY_COUNT; i++)
+    {
+        if (!gpu_timer_pending[i])
+            continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(gpu_timer_queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if (available)
+        {
+            GLuint64 elapsed_ns = 0;
+            glGetQueryObjectui64v(gpu_timer_queries[i], GL_QUERY_RESULT, &elapsed_ns);
+            frame_profiler_add(FrameProfilerStage_Shader, (float)(elapsed_ns / 1000000.0));
+            gpu_timer_pending[i] = false;
+        }
+    }
+
+    if (!frame_profiler_is_enabled() || gpu_timer_pending[gpu_timer_index])
+        return false;
+
+    glBeginQuery(GL_TIME_ELAPSED, gpu_timer_queries[gpu_timer_index]);
+    return true;
+#else
+    return false;
+#endif
+}
+
+static void end_gpu_timer(void)
+{
+#if defined(GL_TIME_ELAPSED)
+    glEndQuery(GL_TIME_ELAPSED);
+    gpu_timer_pending[gpu_timer_index] = true;
+    gpu_timer_index = (gpu_timer_index + 1) % GPU_TIMER_QUERY_COUNT;
+#endif
+}
+
 static void render_gui(void)
 {
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
@@ -471,31 +774,59 @@ static void render_emu_normal(void)
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+// The normal pass only depends on the frame pixels and size, so when
+// the core reports no changed lines since the last upload it is skipped
+static bool is_system_frame_unchanged(void)
+{
+    int width = current_runtime.screen_width;
+    int height = current_runtime.screen_height;
+
+    bool unchanged = emu_texture_valid &&
+            (width == last_system_frame_width) &&
+            (height == last_system_frame_height) &&
+            (emu_frame_generation == last_system_frame_generation);
+
+    if (!unchanged)
+    {
+        last_system_frame_generation = emu_frame_generation;
+        last_system_frame_width = width;
+        last_system_frame_height = height;
+        emu_texture_valid = true;
+    }
+
+    return unchanged;
+}
+
 static void update_system_texture(void)
 {
-    glBindTexture(GL_TEXTURE_2D, system_texture);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, current_runtime.screen_width, current_runtime.screen_height,
-            GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*) emu_frame_buffer);
+    upload_texture(system_texture, current_runtime.screen_width, current_runtime.screen_height, current_runtime.screen_width, emu_frame_buffer);
 }
 
 static void update_debug_textures(void)
 {
-    for (int s = 0; s < 5; s++)
+    if (debug_textures_generation[Debug_View_Framebuffers] != emu_debug_view_generation[Debug_View_Framebuffers])
     {
-        glBindTexture(GL_TEXTURE_2D, ogl_renderer_emu_debug_framebuffer[s]);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, GLYNX_SCREEN_WIDTH, GLYNX_SCREEN_HEIGHT,
-                GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*) emu_debug_framebuffer[s]);
+        debug_textures_generation[Debug_View_Framebuffers] = emu_debug_view_generation[Debug_View_Framebuffers];
+
+        for (int s = 0; s < 5; s++)
+        {
+            upload_texture(ogl_renderer_emu_debug_framebuffer[s], GLYNX_SCREEN_WIDTH, GLYNX_SCREEN_HEIGHT, GLYNX_SCREEN_WIDTH, emu_debug_framebuffer[s]);
+        }
     }
 
-    for (int s = 0; s < DEBUG_MAX_SPRITES; s++)
+    if (debug_textures_generation[Debug_View_Sprites] != emu_debug_view_generation[Debug_View_Sprites])
     {
-        int w = emu_debug_sprite_widths[s];
-        int h = emu_debug_sprite_heights[s];
-        if (w > 0 && h > 0)
+        debug_textures_generation[Debug_View_Sprites] = emu_debug_view_generation[Debug_View_Sprites];
+
+        for (int s = 0; s < DEBUG_MAX_SPRITES; s++)
         {
-            glBindTexture(GL_TEXTURE_2D, ogl_renderer_emu_debug_sprites[s]);
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 512, 512,
-                    GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*) emu_debug_sprite_buffers[s]);
+            int w = emu_debug_sprite_widths[s];
+            int h = emu_debug_sprite_heights[s];
+            // Only the sprite area is sampled, see gui_debug_scb_viewer.cpp
+            if (w > 0 && h > 0)
+            {
+                upload_texture(ogl_renderer_emu_debug_sprites[s], MIN(w, 512), MIN(h, 512), 512, emu_debug_sprite_buffers[s]);
+            }
         }
     }
 }
@@ -516,8 +847,7 @@ static void update_savestates_texture(void)
     {
         int width = emu_savestates_screenshots[i].width;
         int height = emu_savestates_screenshots[i].height;
-        glBindTexture(GL_TEXTURE_2D, ogl_renderer_emu_savestates);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*) emu_savestates_screenshots[i].data);
+        upload_texture(ogl_renderer_emu_savestates, width, height, width, emu_savestates_screenshots[i].data);
     }
 }
 
@@ -55,6 +55,8 @@ EXTERN bool ogl_renderer_init(void);
 EXTERN void ogl_renderer_destroy(void);
 EXTERN void ogl_renderer_begin_render(void);
 EXTERN void ogl_renderer_render(void);
+EXTERN bool ogl_renderer_is_frame_unchanged(void);
+EXTERN void ogl_renderer_render_gui(void);
 EXTERN void ogl_renderer_end_render(void);
 EXTERN void ogl_renderer_set_screen_geometry(const OglRendererScreenGeometry* geometry);
 EXTERN uint32_t ogl_renderer_get_screen_texture(void);
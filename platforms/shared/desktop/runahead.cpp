@@ -78,8 +78,10 @@ void runahead_run(int frames, u8* frame_buffer, s16* sample_buffer, int* sample_
         return;
     }
 
-    // Run the speculative frames with the same input, discarding their audio
-    // and keeping only the last rendered frame.
+    // Run the speculative frames with the same input, without synthesizing
+    // their audio and keeping only the last rendered frame.
+    core->GetAudio()->SetSkipSamples(true);
+
     for (int i = 0; i < frames; i++)
     {
         int discarded_samples = 0;
@@ -87,6 +89,9 @@ void runahead_run(int frames, u8* frame_buffer, s16* sample_buffer, int* sample_
         core->RunToVBlank(frame_buffer, runahead_audio, &discarded_samples, NULL, render);
     }
 
+    // The restored state brings back the audio levels of the real timeline
+    core->GetAudio()->SetSkipSamples(false);
+
     // Roll back to the authoritative frame. If restoring ever fails, the
     // authoritative state is unrecoverable, so keep the (valid) speculative
     // state as the new timeline and disable run-ahead. Emulation continues
@@ -18,6 +18,8 @@
  */
 
 #include <string>
+#include <vector>
+#include <atomic>
 #define SOUND_QUEUE_IMPORT
 #include "sound_queue.h"
 #include "utils.h"
@@ -26,17 +28,49 @@
 //#define SOUND_QUEUE_DEBUG(x, ...) Debug(x, ## __VA_ARGS__)
 
 static SDL_AudioStream* sound_queue_stream;
+static SDL_Mutex* sound_queue_mutex;
 static bool sound_queue_sound_open;
-static int sound_queue_max_queued_bytes;
+static int sound_queue_max_queued_samples;
 static int sound_queue_buffer_size;
-static int sound_queue_bytes_per_second;
+static int sound_queue_samples_per_second;
+static int sound_queue_channel_count;
+static bool sound_queue_dynamic_rate;
+static double sound_queue_rate_ratio;
+static double sound_queue_resample_pos;
+static bool sound_queue_resample_primed;
+static s16 sound_queue_resample_last[2];
+static std::vector<s16> sound_queue_resample_buffer;
+
+// Single producer (sound_queue_write) single consumer (audio callback)
+// ring, indexes are free running sample counters
+static std::vector<s16> sound_queue_ring;
+static u32 sound_queue_ring_mask;
+static std::atomic<u32> sound_queue_ring_read(0);
+static std::atomic<u32> sound_queue_ring_write(0);
+static std::atomic<bool> sound_queue_ring_primed(false);
+static std::atomic<bool> sound_queue_ring_starved(false);
+static std::atomic<u32> sound_queue_underruns(0);
+static std::atomic<u32> sound_queue_overruns(0);
+
+static const double k_dynamic_rate_max_delta = 0.005;
+static const Uint64 k_sync_wait_timeout_ns = 100000000;
 
 static bool is_running_in_wsl(void);
+static void reset_resampler(void);
+static int resample(s16* samples, int count, int queued);
+static void reset_ring(int capacity);
+static int get_ring_fill(void);
+static int push_ring(const s16* samples, int count);
+static void SDLCALL audio_callback(void* userdata, SDL_AudioStream* stream, int additional_amount, int total_amount);
 
 void sound_queue_init(void)
 {
     InitPointer(sound_queue_stream);
     sound_queue_sound_open = false;
+    sound_queue_mutex = SDL_CreateMutex();
+    sound_queue_dynamic_rate = false;
+    reset_resampler();
+    reset_ring(0);
 
     int audio_drivers_count = SDL_GetNumAudioDrivers();
 
@@ -84,15 +118,28 @@ void sound_queue_init(void)
 void sound_queue_destroy(void)
 {
     sound_queue_stop();
+
+    if (sound_queue_mutex)
+    {
+        SDL_DestroyMutex(sound_queue_mutex);
+        InitPointer(sound_queue_mutex);
+    }
 }
 
 bool sound_queue_start(int sample_rate, int channel_count, int buffer_size, int buffer_count)
 {
     Debug("Sound Queue: Starting with %d Hz, %d channels, %d buffer size, %d buffers ...", sample_rate, channel_count, buffer_size, buffer_count);
 
+    SDL_LockMutex(sound_queue_mutex);
+
     sound_queue_buffer_size = buffer_size;
-    sound_queue_max_queued_bytes = buffer_size * buffer_count * (int)sizeof(s16);
-    sound_queue_bytes_per_second = sample_rate * channel_count * (int)sizeof(s16);
+    sound_queue_max_queued_samples = buffer_size * buffer_count;
+    sound_queue_samples_per_second = sample_rate * channel_count;
+    sound_queue_channel_count = CLAMP(channel_count, 1, 2);
+    reset_resampler();
+    reset_ring(sound_queue_max_queued_samples * 2);
+    sound_queue_underruns = 0;
+    sound_queue_overruns = 0;
 
     SDL_AudioSpec spec;
     spec.freq = sample_rate;
@@ -101,11 +148,12 @@ bool sound_queue_start(int sample_rate, int channel_count, int buffer_size, int
 
     Debug("Sound Queue: Spec - frequency: %d format: 0x%04X channels: %d", spec.freq, spec.format, spec.channels);
 
-    sound_queue_stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, NULL, NULL);
+    sound_queue_stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, audio_callback, NULL);
 
     if (!sound_queue_stream)
     {
         SDL_ERROR("SDL_OpenAudioDeviceStream");
+        SDL_UnlockMutex(sound_queue_mutex);
         return false;
     }
 
@@ -116,11 +164,15 @@ bool sound_queue_start(int sample_rate, int channel_count, int buffer_size, int
     SDL_ResumeAudioStreamDevice(sound_queue_stream);
     sound_queue_sound_open = true;
 
+    SDL_UnlockMutex(sound_queue_mutex);
+
     return true;
 }
 
 void sound_queue_stop(void)
 {
+    SDL_LockMutex(sound_queue_mutex);
+
     if (sound_queue_sound_open)
     {
         sound_queue_sound_open = false;
@@ -133,13 +185,16 @@ void sound_queue_stop(void)
 
         Debug("Sound Queue: Stopped");
     }
+
+    SDL_UnlockMutex(sound_queue_mutex);
 }
 
 int sound_queue_get_sample_count(void)
 {
-    if (!sound_queue_stream)
-        return 0;
-    return SDL_GetAudioStreamQueued(sound_queue_stream) / (int)sizeof(s16);
+    SDL_LockMutex(sound_queue_mutex);
+    int count = sound_queue_stream ? get_ring_fill() + (SDL_GetAudioStreamQueued(sound_queue_stream) / (int)sizeof(s16)) : 0;
+    SDL_UnlockMutex(sound_queue_mutex);
+    return count;
 }
 
 bool sound_queue_is_open(void)
@@ -147,46 +202,287 @@ bool sound_queue_is_open(void)
     return sound_queue_sound_open;
 }
 
+void sound_queue_set_dynamic_rate(bool enabled)
+{
+    SDL_LockMutex(sound_queue_mutex);
+
+    if (sound_queue_dynamic_rate != enabled)
+    {
+        sound_queue_dynamic_rate = enabled;
+        reset_resampler();
+    }
+
+    SDL_UnlockMutex(sound_queue_mutex);
+}
+
+double sound_queue_get_rate_ratio(void)
+{
+    SDL_LockMutex(sound_queue_mutex);
+    double ratio = sound_queue_rate_ratio;
+    SDL_UnlockMutex(sound_queue_mutex);
+    return ratio;
+}
+
+float sound_queue_get_latency_ms(void)
+{
+    int queued = sound_queue_get_sample_count();
+    return (sound_queue_samples_per_second > 0) ? (queued * 1000.0f) / (float)sound_queue_samples_per_second : 0.0f;
+}
+
+void sound_queue_get_stats(SoundQueueStats* stats)
+{
+    SDL_LockMutex(sound_queue_mutex);
+    stats->open = sound_queue_sound_open;
+    stats->fill_samples = sound_queue_sound_open ? get_ring_fill() : 0;
+    stats->target_samples = sound_queue_max_queued_samples;
+    stats->underruns = sound_queue_underruns;
+    stats->overruns = sound_queue_overruns;
+    SDL_UnlockMutex(sound_queue_mutex);
+
+    stats->latency_ms = sound_queue_get_latency_ms();
+    stats->rate_ratio = sound_queue_get_rate_ratio();
+}
+
+void sound_queue_reset_stats(void)
+{
+    sound_queue_underruns = 0;
+    sound_queue_overruns = 0;
+}
+
 void sound_queue_write(s16* samples, int count, bool sync)
 {
+    SDL_LockMutex(sound_queue_mutex);
+
     if (!sound_queue_sound_open || !sound_queue_stream)
+    {
+        SDL_UnlockMutex(sound_queue_mutex);
         return;
-
-    int bytes = count * (int)sizeof(s16);
-    int queued = SDL_GetAudioStreamQueued(sound_queue_stream);
+    }
 
     if (count > sound_queue_buffer_size)
     {
         Log("Sound Queue: Write exceeds queue buffer size (%d > %d)", count, sound_queue_buffer_size);
     }
 
-    if (queued == 0)
-    {
-        SOUND_QUEUE_DEBUG("Sound Queue: Underrun detected, queue was empty");
-    }
+    int fill = get_ring_fill();
 
     if (sync)
     {
-        int room = sound_queue_max_queued_bytes - queued;
-        if (room < bytes)
+        if (fill + count > sound_queue_max_queued_samples)
         {
-            SOUND_QUEUE_DEBUG("Sound Queue: Sync overrun, queued %d >= max %d, waiting...", queued, sound_queue_max_queued_bytes);
-            int needed = bytes - room;
-            int wait_ms = (needed * 1000) / sound_queue_bytes_per_second;
-            if (wait_ms >= 1)
-                SDL_Delay(wait_ms);
+            SOUND_QUEUE_DEBUG("Sound Queue: Sync overrun, queued %d >= max %d, waiting...", fill, sound_queue_max_queued_samples);
+
+            // Don't hold the lock while waiting, the stream may be restarted meanwhile
+            SDL_UnlockMutex(sound_queue_mutex);
+
+            Uint64 start = SDL_GetTicksNS();
+
+            while (true)
+            {
+                int needed = get_ring_fill() + count - sound_queue_max_queued_samples;
+                if (needed <= 0)
+                    break;
+                if ((SDL_GetTicksNS() - start) >= k_sync_wait_timeout_ns)
+                    break;
+
+                SDL_DelayPrecise(((Uint64)needed * SDL_NS_PER_SECOND) / (Uint64)sound_queue_samples_per_second);
+            }
+
+            SDL_LockMutex(sound_queue_mutex);
+
+            if (!sound_queue_sound_open || !sound_queue_stream)
+            {
+                SDL_UnlockMutex(sound_queue_mutex);
+                return;
+            }
+
+            fill = get_ring_fill();
         }
     }
     else
     {
-        if (queued >= sound_queue_max_queued_bytes)
+        if (fill >= sound_queue_max_queued_samples)
         {
-            SOUND_QUEUE_DEBUG("Sound Queue: Async overrun, dropping frame (queued %d >= max %d)", queued, sound_queue_max_queued_bytes);
+            SOUND_QUEUE_DEBUG("Sound Queue: Async overrun, dropping frame (queued %d >= max %d)", fill, sound_queue_max_queued_samples);
+            sound_queue_overruns++;
+            SDL_UnlockMutex(sound_queue_mutex);
             return;
         }
     }
 
-    SDL_PutAudioStreamData(sound_queue_stream, samples, bytes);
+    if (sound_queue_dynamic_rate)
+    {
+        count = resample(samples, count, fill);
+        samples = sound_queue_resample_buffer.data();
+    }
+
+    if (push_ring(samples, count) < count)
+        sound_queue_overruns++;
+
+    SDL_UnlockMutex(sound_queue_mutex);
+}
+
+static void reset_ring(int capacity)
+{
+    u32 size = 1;
+    while ((int)size < capacity)
+        size <<= 1;
+
+    sound_queue_ring.assign(size, 0);
+    sound_queue_ring_mask = size - 1;
+    sound_queue_ring_read = 0;
+    sound_queue_ring_write = 0;
+    sound_queue_ring_primed = false;
+    sound_queue_ring_starved = false;
+}
+
+static int get_ring_fill(void)
+{
+    u32 write = sound_queue_ring_write.load(std::memory_order_relaxed);
+    u32 read = sound_queue_ring_read.load(std::memory_order_acquire);
+    return (int)(write - read);
+}
+
+static int push_ring(const s16* samples, int count)
+{
+    u32 write = sound_queue_ring_write.load(std::memory_order_relaxed);
+    u32 read = sound_queue_ring_read.load(std::memory_order_acquire);
+    int room = (int)(sound_queue_ring.size() - (write - read));
+
+    // Keep whole frames so the channels never swap
+    count = MIN(count, room);
+    count -= count % sound_queue_channel_count;
+
+    if (count <= 0)
+        return 0;
+
+    u32 index = write & sound_queue_ring_mask;
+    int first = MIN(count, (int)(sound_queue_ring.size() - index));
+
+    memcpy(&sound_queue_ring[index], samples, first * sizeof(s16));
+    if (count > first)
+        memcpy(&sound_queue_ring[0], samples + first, (count - first) * sizeof(s16));
+
+    sound_queue_ring_write.store(write + count, std::memory_order_release);
+    sound_queue_ring_primed = true;
+
+    return count;
+}
+
+// Runs on the SDL audio thread, only touches the read index
+static void SDLCALL audio_callback(void* userdata, SDL_AudioStream* stream, int additional_amount, int total_amount)
+{
+    UNUSED(userdata);
+    UNUSED(total_amount);
+
+    int wanted = additional_amount / (int)sizeof(s16);
+
+    if (wanted <= 0)
+        return;
+
+    u32 read = sound_queue_ring_read.load(std::memory_order_relaxed);
+    u32 write = sound_queue_ring_write.load(std::memory_order_acquire);
+    int count = MIN(wanted, (int)(write - read));
+
+    if (count > 0)
+    {
+        u32 index = read & sound_queue_ring_mask;
+        int first = MIN(count, (int)(sound_queue_ring.size() - index));
+
+        SDL_PutAudioStreamData(stream, &sound_queue_ring[index], first * (int)sizeof(s16));
+        if (count > first)
+            SDL_PutAudioStreamData(stream, &sound_queue_ring[0], (count - first) * (int)sizeof(s16));
+
+        sound_queue_ring_read.store(read + count, std::memory_order_release);
+        sound_queue_ring_starved = false;
+    }
+
+    if (count < wanted)
+    {
+        // Count each starvation once, not every callback while it lasts
+        if (sound_queue_ring_primed && !sound_queue_ring_starved)
+        {
+            sound_queue_underruns++;
+            sound_queue_ring_starved = true;
+            SOUND_QUEUE_DEBUG("Sound Queue: Underrun detected, queue was empty");
+        }
+
+        static const s16 silence[512] = { };
+        int remaining = wanted - count;
+
+        while (remaining > 0)
+        {
+            int chunk = MIN(remaining, 512);
+            SDL_PutAudioStreamData(stream, silence, chunk * (int)sizeof(s16));
+            remaining -= chunk;
+        }
+    }
+}
+
+static void reset_resampler(void)
+{
+    sound_queue_rate_ratio = 1.0;
+    sound_queue_resample_pos = 0.0;
+    sound_queue_resample_primed = false;
+    sound_queue_resample_last[0] = 0;
+    sound_queue_resample_last[1] = 0;
+}
+
+// Dynamic rate control: stretch or shrink each block by a small ratio
+// so the queue converges to half full instead of drifting to an
+// underrun or to a blocking write when the emulator is paced by the display
+static int resample(s16* samples, int count, int queued)
+{
+    int channels = sound_queue_channel_count;
+    int frames = count / channels;
+
+    if (frames <= 0)
+        return 0;
+
+    if (!sound_queue_resample_primed)
+    {
+        for (int c = 0; c < channels; c++)
+            sound_queue_resample_last[c] = samples[c];
+        sound_queue_resample_primed = true;
+    }
+
+    double fill = (sound_queue_max_queued_samples > 0) ? (double)queued / (double)sound_queue_max_queued_samples : 0.5;
+    fill = CLAMP(fill, 0.0, 1.0);
+    sound_queue_rate_ratio = 1.0 + (k_dynamic_rate_max_delta * (1.0 - (2.0 * fill)));
+
+    double step = 1.0 / sound_queue_rate_ratio;
+    int max_frames = (int)(frames * (1.0 + k_dynamic_rate_max_delta)) + 2;
+
+    if ((int)sound_queue_resample_buffer.size() < max_frames * channels)
+        sound_queue_resample_buffer.resize(max_frames * channels);
+
+    s16* out = sound_queue_resample_buffer.data();
+    int out_frames = 0;
+    double pos = sound_queue_resample_pos;
+
+    // Index 0 is the last frame of the previous block, index i is input frame i - 1
+    while ((pos < (double)frames) && (out_frames < max_frames))
+    {
+        int i = (int)pos;
+        float frac = (float)(pos - i);
+
+        for (int c = 0; c < channels; c++)
+        {
+            float a = (i == 0) ? sound_queue_resample_last[c] : samples[((i - 1) * channels) + c];
+            float b = samples[(i * channels) + c];
+            out[(out_frames * channels) + c] = (s16)(a + ((b - a) * frac));
+        }
+
+        out_frames++;
+        pos += step;
+    }
+
+    sound_queue_resample_pos = MAX(pos - frames, 0.0);
+
+    for (int c = 0; c < channels; c++)
+        sound_queue_resample_last[c] = samples[((frames - 1) * channels) + c];
+
+    return out_frames * channels;
 }
 
 static bool is_running_in_wsl(void)
@@ -30,6 +30,17 @@
     #define EXTERN extern
 #endif
 
+struct SoundQueueStats
+{
+    bool open;
+    int fill_samples;
+    int target_samples;
+    u32 underruns;
+    u32 overruns;
+    float latency_ms;
+    double rate_ratio;
+};
+
 EXTERN void sound_queue_init(void);
 EXTERN void sound_queue_destroy(void);
 EXTERN bool sound_queue_start(int sample_rate, int channel_count, int buffer_size = GLYNX_AUDIO_QUEUE_SIZE, int buffer_count = 3);
@@ -37,6 +48,11 @@ EXTERN void sound_queue_stop(void);
 EXTERN void sound_queue_write(s16* samples, int count, bool sync);
 EXTERN int sound_queue_get_sample_count(void);
 EXTERN bool sound_queue_is_open(void);
+EXTERN void sound_queue_set_dynamic_rate(bool enabled);
+EXTERN double sound_queue_get_rate_ratio(void);
+EXTERN float sound_queue_get_latency_ms(void);
+EXTERN void sound_queue_get_stats(SoundQueueStats* stats);
+EXTERN void sound_queue_reset_stats(void);
 
 #undef SOUND_QUEUE_IMPORT
 #undef EXTERN
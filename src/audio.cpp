@@ -28,8 +28,14 @@ Audio::Audio(Mikey* mikey)
     m_mikey = mikey;
     m_mute = false;
     m_vgm_recording_enabled = false;
+    m_vgm_sample_phase = 0;
     m_is_lynx2 = true;
     m_master_volume = 1.0f;
+    m_sample_rate = GLYNX_AUDIO_SAMPLE_RATE;
+    m_lpf_cutoff = 1000.0f;
+    m_lpf_alpha_q15 = 0;
+    m_channel_buffers_enabled = false;
+    m_skip_samples = false;
 
     for (int i = 0; i < 4; i++)
     {
@@ -37,6 +43,9 @@ Audio::Audio(Mikey* mikey)
         m_channel[i].volume = 1.0f;
     }
 
+    ComputeBlipKernel();
+    ComputeAttenuationLUT();
+    UpdateLowpass();
     Reset(true);
 }
 
@@ -63,10 +72,17 @@ void Audio::Reset(bool is_lynx2)
 {
     m_is_lynx2 = is_lynx2;
     m_sample_phase = 0;
-    m_buffer_pos = 0;
+    m_frame_cycles = 0;
+    m_channel_pos = 0;
     m_frame_samples = 0;
     m_lpf_left = 0;
     m_lpf_right = 0;
+    m_mikey_audio_revision = m_mikey->GetAudioRevision() - 1;
+
+    memset(m_level, 0, sizeof(m_level));
+    m_mix_level[0] = 0;
+    m_mix_level[1] = 0;
+    ClearBlipBuffer();
 
     for (int i = 0; i < 4; i++)
         memset(m_channel[i].buffer, 0, sizeof(s8) * GLYNX_AUDIO_BUFFER_SIZE);
@@ -74,48 +90,269 @@ void Audio::Reset(bool is_lynx2)
 
 void Audio::EndFrame(s16* sample_buffer, int* sample_count)
 {
-    m_frame_samples = m_buffer_pos;
+    u64 position = (u64)m_sample_phase + (u64)m_frame_cycles * m_sample_rate;
+    u32 count = (u32)(position / GLYNX_MASTER_CLOCK);
+    m_sample_phase = (u32)(position % GLYNX_MASTER_CLOCK);
+    m_frame_cycles = 0;
+
+    if (count > k_audio_frame_capacity)
+    {
+        Debug("WARNING: Audio buffer overflow");
+        count = k_audio_frame_capacity;
+    }
+
+    if (m_skip_samples)
+    {
+        SkipFrame();
+        if (IsValidPointer(sample_count))
+            *sample_count = 0;
+        return;
+    }
+
+    // Picks up volume and mute changes made since the last amplitude change
+    MixLevels(count, 0);
+    FillChannelBuffers(count);
+
+    m_frame_samples = count * 2;
+
+    s32* blip_left = m_blip_buffer[0];
+    s32* blip_right = m_blip_buffer[1];
 
     if (IsValidPointer(sample_buffer) && IsValidPointer(sample_count))
     {
         *sample_count = m_frame_samples;
 
-        for (u32 i = 0; i + 1 < m_frame_samples; i += 2)
+        s32* mix = m_mix_buffer;
+        s32 integrator_left = m_blip_integrator[0];
+        s32 integrator_right = m_blip_integrator[1];
+        s32 lpf_left = m_lpf_left;
+        s32 lpf_right = m_lpf_right;
+        s64 alpha = m_lpf_alpha_q15;
+
+        // Integration and the low-pass filter are recursive, run them first
+        for (u32 i = 0; i < count; i++)
         {
-            s32 x_left = 0;
-            x_left += (s32)(m_channel[0].buffer[i + 0] * (m_channel[0].mute ? 0.0f : m_channel[0].volume));
-            x_left += (s32)(m_channel[1].buffer[i + 0] * (m_channel[1].mute ? 0.0f : m_channel[1].volume));
-            x_left += (s32)(m_channel[2].buffer[i + 0] * (m_channel[2].mute ? 0.0f : m_channel[2].volume));
-            x_left += (s32)(m_channel[3].buffer[i + 0] * (m_channel[3].mute ? 0.0f : m_channel[3].volume));
-
-            s32 x_right = 0;
-            x_right += (s32)(m_channel[0].buffer[i + 1] * (m_channel[0].mute ? 0.0f : m_channel[0].volume));
-            x_right += (s32)(m_channel[1].buffer[i + 1] * (m_channel[1].mute ? 0.0f : m_channel[1].volume));
-            x_right += (s32)(m_channel[2].buffer[i + 1] * (m_channel[2].mute ? 0.0f : m_channel[2].volume));
-            x_right += (s32)(m_channel[3].buffer[i + 1] * (m_channel[3].mute ? 0.0f : m_channel[3].volume));
+            // Integrate band-limited deltas, result is 8.8 fixed point
+            integrator_left += blip_left[i];
+            integrator_right += blip_right[i];
 
             // Single-pole low-pass filter
             // y += alpha * (x - y)
-            m_lpf_left += ((s32)m_lpf_alpha_q15 * (x_left - m_lpf_left)) >> 15;
-            m_lpf_right += ((s32)m_lpf_alpha_q15 * (x_right - m_lpf_right)) >> 15;
-            s32 y_left = m_lpf_left;
-            s32 y_right = m_lpf_right;
+            lpf_left += (s32)((alpha * ((integrator_left / k_audio_blip_unit) - lpf_left)) >> 15);
+            lpf_right += (s32)((alpha * ((integrator_right / k_audio_blip_unit) - lpf_right)) >> 15);
+
+            mix[(i * 2) + 0] = lpf_left;
+            mix[(i * 2) + 1] = lpf_right;
+        }
+
+        m_blip_integrator[0] = integrator_left;
+        m_blip_integrator[1] = integrator_right;
+        m_lpf_left = lpf_left;
+        m_lpf_right = lpf_right;
+
+        // Volume and clamping have no state, one vectorizable pass over both sides
+        // Output gain is 40 * master volume, as 4.12 fixed point applied to 8.8 samples
+        s32 out_scale = m_mute ? 0 : (s32)(640.0f * m_master_volume + 0.5f);
+        u32 frame_samples = m_frame_samples;
+
+        for (u32 i = 0; i < frame_samples; i++)
+        {
+            s32 out = (mix[i] * out_scale) >> 12;
+            sample_buffer[i] = (s16)CLAMP(out, -32768, 32767);
+        }
+    }
+    else
+    {
+        for (u32 i = 0; i < count; i++)
+        {
+            m_blip_integrator[0] += blip_left[i];
+            m_blip_integrator[1] += blip_right[i];
+        }
+    }
+
+    // Keep the kernel tails that spill into the next frame
+    memmove(blip_left, blip_left + count, k_audio_blip_width * sizeof(s32));
+    memmove(blip_right, blip_right + count, k_audio_blip_width * sizeof(s32));
+    memset(blip_left + k_audio_blip_width, 0, count * sizeof(s32));
+    memset(blip_right + k_audio_blip_width, 0, count * sizeof(s32));
+
+    m_channel_pos = 0;
+}
+
+void Audio::UpdateLevels()
+{
+    Mikey::Mikey_State* state = m_mikey->GetState();
+
+    u64 position = (u64)m_sample_phase + (u64)m_frame_cycles * m_sample_rate;
+    u32 index = (u32)(position / GLYNX_MASTER_CLOCK);
+    u32 phase = (u32)(((position % GLYNX_MASTER_CLOCK) * k_audio_blip_phases) / GLYNX_MASTER_CLOCK);
+
+    if (index > k_audio_frame_capacity)
+    {
+        index = k_audio_frame_capacity;
+        phase = 0;
+    }
+
+    FillChannelBuffers(index);
+
+    // Lynx II
+    if (likely(m_is_lynx2))
+    {
+        // MSTEREO ($FD50) controls channel routing to each ear (bit=1 disables)
+        // MPAN ($FD44) enables attenuation per channel/ear (bit=1 enables)
+        // ATTEN_X ($FD40-$FD43) sets volume per channel: bits 7-4=left, 3-0=right (0=silent, 15=full).
+
+        u8 mstereo = state->MSTEREO;
+        u8 mpan = state->MPAN;
+        const u8* atten = &state->ATTEN_A;
 
-            s32 out_left = 0;
-            s32 out_right = 0;
+        for (int ch = 0; ch < 4; ch++)
+        {
+            s8 sample = state->audio[ch].internal_mix ? state->audio[ch].output : 0;
+            u8 ch_atten = atten[ch];
 
-            if (!m_mute)
+            // Left
+            if (IS_NOT_SET_BIT(mstereo, 4 + ch))
             {
-                out_left = CLAMP((s32)((float)y_left * 40.0f * m_master_volume), -32768, 32767);
-                out_right = CLAMP((s32)((float)y_right * 40.0f * m_master_volume), -32768, 32767);
+                int att = IS_SET_BIT(mpan, 4 + ch) ? (ch_atten >> 4) : 15;
+                m_level[ch][0] = m_atten_lut[att][(u8)sample];
             }
+            else
+                m_level[ch][0] = 0;
+
+            // Right
+            if (IS_NOT_SET_BIT(mstereo, ch))
+            {
+                int att = IS_SET_BIT(mpan, ch) ? (ch_atten & 0x0F) : 15;
+                m_level[ch][1] = m_atten_lut[att][(u8)sample];
+            }
+            else
+                m_level[ch][1] = 0;
+        }
+    }
+    // Lynx I
+    else
+    {
+        for (int ch = 0; ch < 4; ch++)
+        {
+            s8 sample = state->audio[ch].internal_mix ? state->audio[ch].output : 0;
+            m_level[ch][0] = sample;
+            m_level[ch][1] = sample;
+        }
+    }
+
+    MixLevels(index, phase);
+}
+
+void Audio::MixLevels(u32 index, u32 phase)
+{
+    s32 gain[4];
+
+    for (int ch = 0; ch < 4; ch++)
+        gain[ch] = m_channel[ch].mute ? 0 : (s32)(m_channel[ch].volume * 256.0f + 0.5f);
 
-            sample_buffer[i + 0] = (s16)out_left;
-            sample_buffer[i + 1] = (s16)out_right;
+    for (int side = 0; side < 2; side++)
+    {
+        s32 mix = 0;
+
+        for (int ch = 0; ch < 4; ch++)
+            mix += m_level[ch][side] * gain[ch];
+
+        s32 delta = mix - m_mix_level[side];
+
+        if (delta == 0)
+            continue;
+
+        m_mix_level[side] = mix;
+
+        // Add a band-limited step at the exact sub-sample position
+        s32* buffer = &m_blip_buffer[side][index];
+        const s16* kernel = m_blip_kernel[phase];
+
+        for (int i = 0; i < k_audio_blip_width; i++)
+            buffer[i] += delta * kernel[i];
+    }
+}
+
+void Audio::SettleLevels()
+{
+    m_mikey_audio_revision = m_mikey->GetAudioRevision();
+    UpdateLevels();
+    ClearBlipBuffer();
+}
+
+void Audio::FillChannelBuffers(u32 count)
+{
+    if (!m_channel_buffers_enabled)
+        return;
+
+    for (u32 i = m_channel_pos; i < count; i++)
+    {
+        for (int ch = 0; ch < 4; ch++)
+        {
+            m_channel[ch].buffer[(i * 2) + 0] = m_level[ch][0];
+            m_channel[ch].buffer[(i * 2) + 1] = m_level[ch][1];
         }
     }
 
-    m_buffer_pos = 0;
+    if (count > m_channel_pos)
+        m_channel_pos = count;
+}
+
+void Audio::ClearBlipBuffer()
+{
+    memset(m_blip_buffer, 0, sizeof(m_blip_buffer));
+    m_blip_integrator[0] = m_mix_level[0] * k_audio_blip_unit;
+    m_blip_integrator[1] = m_mix_level[1] * k_audio_blip_unit;
+}
+
+void Audio::ComputeAttenuationLUT()
+{
+    for (int att = 0; att < 16; att++)
+    {
+        for (int i = 0; i < 256; i++)
+            m_atten_lut[att][i] = (s8)(((s8)i * att) / 15);
+    }
+}
+
+void Audio::ComputeBlipKernel()
+{
+    const double pi = 3.14159265358979323846;
+    // Cutoff as a fraction of the output rate, just below Nyquist
+    const double cutoff = 0.42;
+    const int center = (k_audio_blip_width / 2) - 1;
+
+    for (int p = 0; p < k_audio_blip_phases; p++)
+    {
+        double taps[k_audio_blip_width];
+        double sum = 0.0;
+
+        for (int i = 0; i < k_audio_blip_width; i++)
+        {
+            // Windowed sinc impulse, step placed between taps center and center + 1
+            double t = (double)(i - center) - ((double)p / k_audio_blip_phases);
+            double x = 2.0 * cutoff * t;
+            double sinc = (fabs(x) < 1e-9) ? 1.0 : sin(pi * x) / (pi * x);
+            double n = (t + (k_audio_blip_width / 2)) / k_audio_blip_width;
+            double window = 0.42 - 0.5 * cos(2.0 * pi * n) + 0.08 * cos(4.0 * pi * n);
+            taps[i] = sinc * window;
+            sum += taps[i];
+        }
+
+        // Every phase must add up to exactly one unit so the integrator never drifts
+        int total = 0;
+        int peak = 0;
+
+        for (int i = 0; i < k_audio_blip_width; i++)
+        {
+            m_blip_kernel[p][i] = (s16)floor((taps[i] / sum) * k_audio_blip_unit + 0.5);
+            total += m_blip_kernel[p][i];
+            if (m_blip_kernel[p][i] > m_blip_kernel[p][peak])
+                peak = i;
+        }
+
+        m_blip_kernel[p][peak] += (s16)(k_audio_blip_unit - total);
+    }
 }
 
 void Audio::SetVolume(int channel, float volume)
@@ -133,9 +370,66 @@ void Audio::SetMasterVolume(float volume)
 
 void Audio::SetLowpassCutoff(float fc)
 {
-    const float fs = 44100.0f;
+    m_lpf_cutoff = fc;
+    UpdateLowpass();
+}
+
+void Audio::SetSampleRate(int sample_rate)
+{
+    sample_rate = CLAMP(sample_rate, 8000, GLYNX_AUDIO_MAX_SAMPLE_RATE);
+
+    if ((u32)sample_rate == m_sample_rate)
+        return;
+
+    // Pending deltas were placed for the old rate, restart from the current level
+    m_sample_rate = (u32)sample_rate;
+    m_sample_phase = 0;
+    m_channel_pos = 0;
+    ClearBlipBuffer();
+    UpdateLowpass();
+}
+
+int Audio::GetSampleRate()
+{
+    return (int)m_sample_rate;
+}
+
+void Audio::SetSkipSamples(bool skip)
+{
+    if (skip == m_skip_samples)
+        return;
+
+    m_skip_samples = skip;
+
+    // Resume from the levels the channels have now, the deltas of a
+    // partially synthesized frame are dropped
+    SkipFrame();
+}
+
+// Brings the mixer levels up to date with Mikey without producing samples,
+// the filter starts from the settled level so resuming doesn't click
+void Audio::SkipFrame()
+{
+    m_frame_samples = 0;
+    m_channel_pos = 0;
+    SettleLevels();
+    m_lpf_left = m_blip_integrator[0] / k_audio_blip_unit;
+    m_lpf_right = m_blip_integrator[1] / k_audio_blip_unit;
+}
+
+void Audio::SetChannelBuffersEnabled(bool enabled)
+{
+    if (enabled && !m_channel_buffers_enabled)
+        m_channel_pos = 0;
+
+    m_channel_buffers_enabled = enabled;
+}
+
+void Audio::UpdateLowpass()
+{
+    const float fs = (float)m_sample_rate;
     // alpha = 1 - exp(-2 * pi * fc / fs)
-    float alpha = 1.0f - expf(-2.0f * 3.14159265358979323846f * fc / fs);
+    float alpha = 1.0f - expf(-2.0f * 3.14159265358979323846f * m_lpf_cutoff / fs);
     alpha = CLAMP(alpha, 0.0f, 0.9999f);
     // convert to Q1.15 fixed point
     m_lpf_alpha_q15 = (u16)(alpha * 32768.0f + 0.5f);
@@ -152,15 +446,19 @@ void Audio::LoadState(std::istream& stream, int version)
     StateSerializer serializer(stream);
     Serialize(serializer, version);
 
-    if (m_buffer_pos >= GLYNX_AUDIO_BUFFER_SIZE)
-        m_buffer_pos = 0;
-    else
-        m_buffer_pos &= ~1u;
-
     if (m_frame_samples > GLYNX_AUDIO_BUFFER_SIZE)
         m_frame_samples = GLYNX_AUDIO_BUFFER_SIZE;
 
     m_frame_samples &= ~1u;
+    m_channel_pos = 0;
+
+    if (version < 27)
+    {
+        m_frame_cycles = 0;
+        SettleLevels();
+    }
+    else
+        m_mikey_audio_revision = m_mikey->GetAudioRevision();
 }
 
 void Audio::Serialize(StateSerializer& s, int version)
@@ -172,13 +470,51 @@ void Audio::Serialize(StateSerializer& s, int version)
         m_sample_phase = 0;
     G_SERIALIZE(s, m_lpf_left);
     G_SERIALIZE(s, m_lpf_right);
-    G_SERIALIZE(s, m_buffer_pos);
+
+    if (version < 27)
+    {
+        // Older states stored the 44100 Hz point-sampled channel buffers
+        const int legacy_buffer_size = 2384;
+        s8 legacy_buffer[legacy_buffer_size];
+        u32 legacy_buffer_pos = 0;
+
+        G_SERIALIZE(s, legacy_buffer_pos);
+        G_SERIALIZE(s, m_frame_samples);
+
+        for (int i = 0; i < 4; i++)
+        {
+            G_SERIALIZE_ARRAY(s, legacy_buffer, legacy_buffer_size);
+        }
+
+        if (s.IsLoading())
+        {
+            m_sample_phase = 0;
+            m_lpf_left *= 256;
+            m_lpf_right *= 256;
+        }
+        return;
+    }
+
     G_SERIALIZE(s, m_frame_samples);
+    G_SERIALIZE(s, m_frame_cycles);
+    G_SERIALIZE_ARRAY(s, &m_level[0][0], 8);
+    G_SERIALIZE_ARRAY(s, m_mix_level, 2);
+    G_SERIALIZE_ARRAY(s, m_blip_integrator, 2);
 
-    for (int i = 0; i < 4; i++)
+    // Only the part of the delta buffer that has been written this frame
+    u64 position = (u64)m_sample_phase + (u64)m_frame_cycles * m_sample_rate;
+    u32 blip_used = (u32)MIN(position / GLYNX_MASTER_CLOCK, (u64)k_audio_frame_capacity) + k_audio_blip_width;
+    G_SERIALIZE(s, blip_used);
+
+    if (s.IsLoading())
     {
-        G_SERIALIZE_ARRAY(s, m_channel[i].buffer, GLYNX_AUDIO_BUFFER_SIZE);
+        memset(m_blip_buffer, 0, sizeof(m_blip_buffer));
+        if (blip_used > k_audio_blip_buffer_size)
+            blip_used = k_audio_blip_buffer_size;
     }
+
+    G_SERIALIZE_ARRAY(s, m_blip_buffer[0], blip_used);
+    G_SERIALIZE_ARRAY(s, m_blip_buffer[1], blip_used);
 }
 
 bool Audio::StartVgmRecording(const char* file_path, int clock_rate, const VgmMetadata& metadata)
@@ -188,6 +524,7 @@ bool Audio::StartVgmRecording(const char* file_path, int clock_rate, const VgmMe
 
     m_vgm_recorder.Start(file_path, clock_rate, metadata);
     m_vgm_recording_enabled = m_vgm_recorder.IsRecording();
+    m_vgm_sample_phase = 0;
 
     // Write initial state of all audio registers to VGM
     if (m_vgm_recording_enabled)
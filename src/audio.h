@@ -26,6 +26,12 @@
 class Mikey;
 class StateSerializer;
 
+static const int k_audio_blip_width = 16;
+static const int k_audio_blip_phases = 32;
+static const int k_audio_blip_unit = 1024;
+static const u32 k_audio_frame_capacity = GLYNX_AUDIO_BUFFER_SIZE / 2;
+static const u32 k_audio_blip_buffer_size = k_audio_frame_capacity + k_audio_blip_width;
+
 class Audio
 {
 public:
@@ -49,6 +55,11 @@ public:
     void SetVolume(int channel, float volume);
     void SetMasterVolume(float volume);
     void SetLowpassCutoff(float fc);
+    void SetSampleRate(int sample_rate);
+    int GetSampleRate();
+    void SetChannelBuffersEnabled(bool enabled);
+    void SetSkipSamples(bool skip);
+    bool IsSkippingSamples();
     void SaveState(std::ostream& stream);
     void LoadState(std::istream& stream, int version);
     void Serialize(StateSerializer& s, int version);
@@ -57,19 +68,44 @@ public:
     bool IsVgmRecording() const;
     VgmRecorder* GetVgmRecorder();
 
+private:
+    void UpdateLevels();
+    void MixLevels(u32 index, u32 phase);
+    void SettleLevels();
+    void SkipFrame();
+    void FillChannelBuffers(u32 count);
+    void ClearBlipBuffer();
+    void ComputeBlipKernel();
+    void ComputeAttenuationLUT();
+    void UpdateLowpass();
+
 private:
     Mikey* m_mikey;
     u32 m_sample_phase;
+    u32 m_sample_rate;
+    u32 m_frame_cycles;
+    u32 m_mikey_audio_revision;
     bool m_mute;
     s32 m_lpf_left;
     s32 m_lpf_right;
     float m_master_volume;
+    float m_lpf_cutoff;
     u16 m_lpf_alpha_q15;
-    u32 m_buffer_pos;
+    u32 m_channel_pos;
+    bool m_channel_buffers_enabled;
+    bool m_skip_samples;
     u32 m_frame_samples;
+    s8 m_level[4][2];
+    s32 m_mix_level[2];
+    s32 m_blip_integrator[2];
+    s32 m_blip_buffer[2][k_audio_blip_buffer_size];
+    s16 m_blip_kernel[k_audio_blip_phases][k_audio_blip_width];
+    s8 m_atten_lut[16][256];
+    s32 m_mix_buffer[GLYNX_AUDIO_BUFFER_SIZE];
     GLYNX_Audio_Channel m_channel[4];
     VgmRecorder m_vgm_recorder;
     bool m_vgm_recording_enabled;
+    u32 m_vgm_sample_phase;
     bool m_is_lynx2;
 };
 
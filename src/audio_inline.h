@@ -25,74 +25,34 @@
 
 inline void Audio::Clock(u32 cycles)
 {
-    u64 sample_phase = (u64)m_sample_phase + (u64)cycles * GLYNX_AUDIO_SAMPLE_RATE;
+    m_frame_cycles += cycles;
 
-    while (sample_phase >= GLYNX_MASTER_CLOCK)
-    {
-        sample_phase -= GLYNX_MASTER_CLOCK;
-        Mikey::Mikey_State* state = m_mikey->GetState();
+    // Mikey bumps the revision whenever a channel output or the mixer changes
+    u32 revision = m_mikey->GetAudioRevision();
 
-        // Lynx II
-        if (likely(m_is_lynx2))
-        {
-            // MSTEREO ($FD50) controls channel routing to each ear (bit=1 disables)
-            // MPAN ($FD44) enables attenuation per channel/ear (bit=1 enables)
-            // ATTEN_X ($FD40-$FD43) sets volume per channel: bits 7-4=left, 3-0=right (0=silent, 15=full).
-
-            u8 mstereo = state->MSTEREO;
-            u8 mpan = state->MPAN;
-            const u8* atten = &state->ATTEN_A;
-
-            for (int ch = 0; ch < 4; ch++)
-            {
-                s8 sample = state->audio[ch].internal_mix ? state->audio[ch].output : 0;
-                u8 ch_atten = atten[ch];
-
-                // Left
-                if (IS_NOT_SET_BIT(mstereo, 4 + ch))
-                {
-                    s32 att = IS_SET_BIT(mpan, 4 + ch) ? (ch_atten >> 4) : 15;
-                    m_channel[ch].buffer[m_buffer_pos + 0] = (sample * att) / 15;
-                }
-                else
-                    m_channel[ch].buffer[m_buffer_pos + 0] = 0;
-
-                // Right
-                if (IS_NOT_SET_BIT(mstereo, ch))
-                {
-                    s32 att = IS_SET_BIT(mpan, ch) ? (ch_atten & 0x0F) : 15;
-                    m_channel[ch].buffer[m_buffer_pos + 1] = (sample * att) / 15;
-                }
-                else
-                    m_channel[ch].buffer[m_buffer_pos + 1] = 0;
-            }
-        }
-        // Lynx I
-        else
-        {
-            for (int ch = 0; ch < 4; ch++)
-            {
-                s8 sample = state->audio[ch].internal_mix ? state->audio[ch].output : 0;
-                m_channel[ch].buffer[m_buffer_pos + 0] = sample;
-                m_channel[ch].buffer[m_buffer_pos + 1] = sample;
-            }
-        }
+    if (unlikely(revision != m_mikey_audio_revision))
+    {
+        m_mikey_audio_revision = revision;
 
-        m_buffer_pos += 2;
+        if (likely(!m_skip_samples))
+            UpdateLevels();
+    }
 
 #ifndef GLYNX_DISABLE_VGMRECORDER
-        if (m_vgm_recording_enabled)
-            m_vgm_recorder.UpdateTiming();
-#endif
+    if (m_vgm_recording_enabled)
+    {
+        // VGM waits are always counted in 44100 Hz samples
+        u64 vgm_phase = (u64)m_vgm_sample_phase + (u64)cycles * 44100;
 
-        if (m_buffer_pos >= GLYNX_AUDIO_BUFFER_SIZE)
+        while (vgm_phase >= GLYNX_MASTER_CLOCK)
         {
-            Debug("WARNING: Audio buffer overflow");
-            m_buffer_pos = 0;
+            vgm_phase -= GLYNX_MASTER_CLOCK;
+            m_vgm_recorder.UpdateTiming();
         }
-    }
 
-    m_sample_phase = (u32)sample_phase;
+        m_vgm_sample_phase = (u32)vgm_phase;
+    }
+#endif
 }
 
 inline void Audio::Mute(bool mute)
@@ -105,6 +65,11 @@ inline Audio::GLYNX_Audio_Channel* Audio::GetChannels()
     return m_channel;
 }
 
+inline bool Audio::IsSkippingSamples()
+{
+    return m_skip_samples;
+}
+
 inline u32 Audio::GetFrameSamples()
 {
     return m_frame_samples;
@@ -41,17 +41,19 @@
 
 #define GLYNX_SCREEN_WIDTH 160
 #define GLYNX_SCREEN_HEIGHT 102
+#define GLYNX_SCREEN_DIRTY_WORDS ((GLYNX_SCREEN_HEIGHT + 31) / 32)
 
 #define GLYNX_MAX_GAMEPADS 1
 
 #define GLYNX_MASTER_CLOCK 16000000
 #define GLYNX_AUDIO_SAMPLE_RATE 44100
-#define GLYNX_AUDIO_BUFFER_SIZE 2384    // (44100 / 37fps) * 2 channels = ~2383.78 samples
+#define GLYNX_AUDIO_MAX_SAMPLE_RATE 96000
+#define GLYNX_AUDIO_BUFFER_SIZE 5190    // (96000 / 37fps) * 2 channels = ~5189.19 samples
 #define GLYNX_AUDIO_QUEUE_SIZE 2384     // (44100 / 37fps) * 2 channels = ~2383.78 samples
 
 #define GLYNX_BIOS_SIZE 0x200
 
-#define GLYNX_SAVESTATE_VERSION 26
+#define GLYNX_SAVESTATE_VERSION 27
 #define GLYNX_SAVESTATE_MIN_VERSION 12
 #define GLYNX_SAVESTATE_MAGIC 0x56191212
 
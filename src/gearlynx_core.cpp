@@ -23,6 +23,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <chrono>
 #include "gearlynx_core.h"
 #include "common.h"
 #include "media.h"
@@ -55,6 +56,12 @@ GearlynxCore::GearlynxCore()
     m_comlynx_sync_user_data = NULL;
     m_comlynx_next_sync_cycle = 0;
     m_comlynx_sync_cycles = COMLYNX_MAX_SYNC_CYCLES;
+    m_input_poll_callback = NULL;
+    m_input_poll_user_data = NULL;
+    m_input_poll_line = 0;
+    ResetInputPollStats();
+    m_frame_profile_enabled = false;
+    ResetFrameProfile();
 }
 
 GearlynxCore::~GearlynxCore()
@@ -91,7 +98,8 @@ void GearlynxCore::Init(GLYNX_Pixel_Format pixel_format)
     m_audio->Init();
     m_bus->Init();
     m_input->Init(m_suzy);
-    m_suzy->Init(m_memory, m_mikey);
+    m_input->SetPollCallback(InputPoll, this);
+    m_suzy->Init(m_memory, m_mikey, &m_total_cycles);
     m_mikey->Init(m_memory, pixel_format);
     m_mikey->SetAudio(m_audio);
     m_m6502->Init(m_memory);
@@ -106,15 +114,39 @@ void GearlynxCore::Init(GLYNX_Pixel_Format pixel_format)
 
 }
 
+static inline u64 profile_clock_ns(void)
+{
+    return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Per component timing costs a clock read per step, only instrumented
+// builds (-DGLYNX_PROFILE) pay for it
+#if defined(GLYNX_PROFILE)
+    #define GLYNX_PROFILE_START() u64 profile_mark = profile ? profile_clock_ns() : 0
+    #define GLYNX_PROFILE_MARK(field) if (profile) { u64 profile_now = profile_clock_ns(); m_frame_profile.field += profile_now - profile_mark; profile_mark = profile_now; }
+#else
+    #define GLYNX_PROFILE_START()
+    #define GLYNX_PROFILE_MARK(field)
+#endif
+
 template<bool debugger>
 bool GearlynxCore::RunToVBlankTemplate(u8* frame_buffer, s16* sample_buffer,
     int* sample_count, GLYNX_Debug_Run* debug, bool render)
 {
+    // Frames nobody will look at keep the DMA timing but produce no pixels,
+    // RenderFrameBuffer() decodes them from video RAM on demand
+    m_mikey->GetLcdScreen()->SetSkipPixels(!render);
     m_mikey->GetLcdScreen()->SetBuffer(frame_buffer);
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     m_suzy->BeginSpriteBoundingBoxFrame();
 #endif
 
+    bool profile = m_frame_profile_enabled;
+#if !defined(GLYNX_PROFILE)
+    UNUSED(profile);
+#endif
+
     if (debugger)
     {
         bool debug_enable = false;
@@ -132,36 +164,49 @@ bool GearlynxCore::RunToVBlankTemplate(u8* frame_buffer, s16* sample_buffer,
 
         bool stop = false;
         u32 failsafe_cycle_count = 0;
+        // Single player sessions never install a sync callback
+        bool comlynx_sync = (m_comlynx_sync_callback != NULL);
 
         do
         {
+            GLYNX_PROFILE_START();
             u32 cpu_cycles = m_m6502->RunInstruction();
             u32 bus_cycles = m_bus->ConsumeCycles();
             u32 suzy_stolen_cycles = m_bus->ConsumeSuzyStolenCycles();
             u32 lynx_cycles = cpu_cycles + bus_cycles;
             u32 suzy_cycles = m_suzy->ApplyBusStall(&lynx_cycles, suzy_stolen_cycles);
             m_total_cycles += lynx_cycles;
-            SynchronizeComLynx();
+            GLYNX_PROFILE_MARK(cpu_ns);
+
+            if (comlynx_sync)
+                SynchronizeComLynx();
 
             //Debug("-> CPU cycles=%u, Lynx cycles=%u", cpu_cycles, lynx_cycles);
 
             if (m_m6502->IsHalted())
             {
                 stop = m_mikey->Clock(lynx_cycles);
+                GLYNX_PROFILE_MARK(mikey_ns);
                 if (m_m6502->IsHalted())
                     m_suzy->Clock(suzy_cycles);
+                GLYNX_PROFILE_MARK(suzy_ns);
             }
             else
             {
                 m_suzy->Clock(suzy_cycles);
+                GLYNX_PROFILE_MARK(suzy_ns);
                 stop = m_mikey->Clock(lynx_cycles);
+                GLYNX_PROFILE_MARK(mikey_ns);
             }
             m_audio->Clock(lynx_cycles);
+            GLYNX_PROFILE_MARK(audio_ns);
 
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
             if (stop)
                 m_suzy->SwapFrameSCBList();
 #endif
+            if (stop)
+                EndInputFrame();
 
             failsafe_cycle_count += lynx_cycles;
             if (failsafe_cycle_count > 450000)
@@ -187,9 +232,15 @@ bool GearlynxCore::RunToVBlankTemplate(u8* frame_buffer, s16* sample_buffer,
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
         m_suzy->EndSpriteBoundingBoxFrame();
 #endif
+        m_suzy->EndFrame();
         if (render)
-            m_mikey->GetLcdScreen()->EndFrame(m_media->GetRotation());
+            EndLcdFrame(profile);
         m_audio->EndFrame(sample_buffer, sample_count);
+        if (profile)
+            m_frame_profile.frames++;
+
+        // The debugger and MCP read Mikey registers between runs
+        m_mikey->SyncState();
 
         return m_m6502->BreakpointHit() || m_m6502->RunToBreakpointHit();
     }
@@ -199,29 +250,40 @@ bool GearlynxCore::RunToVBlankTemplate(u8* frame_buffer, s16* sample_buffer,
 
         bool stop = false;
         u32 failsafe_cycle_count = 0;
+        // Single player sessions never install a sync callback
+        bool comlynx_sync = (m_comlynx_sync_callback != NULL);
 
         do
         {
+            GLYNX_PROFILE_START();
             u32 cpu_cycles = m_m6502->RunInstruction();
             u32 bus_cycles = m_bus->ConsumeCycles();
             u32 suzy_stolen_cycles = m_bus->ConsumeSuzyStolenCycles();
             u32 lynx_cycles = cpu_cycles + bus_cycles;
             u32 suzy_cycles = m_suzy->ApplyBusStall(&lynx_cycles, suzy_stolen_cycles);
             m_total_cycles += lynx_cycles;
-            SynchronizeComLynx();
+            GLYNX_PROFILE_MARK(cpu_ns);
+
+            if (comlynx_sync)
+                SynchronizeComLynx();
 
             if (m_m6502->IsHalted())
             {
                 stop = m_mikey->Clock(lynx_cycles);
+                GLYNX_PROFILE_MARK(mikey_ns);
                 if (m_m6502->IsHalted())
                     m_suzy->Clock(suzy_cycles);
+                GLYNX_PROFILE_MARK(suzy_ns);
             }
             else
             {
                 m_suzy->Clock(suzy_cycles);
+                GLYNX_PROFILE_MARK(suzy_ns);
                 stop = m_mikey->Clock(lynx_cycles);
+                GLYNX_PROFILE_MARK(mikey_ns);
             }
             m_audio->Clock(lynx_cycles);
+            GLYNX_PROFILE_MARK(audio_ns);
 
             failsafe_cycle_count += lynx_cycles;
             if (failsafe_cycle_count > 450000)
@@ -232,12 +294,17 @@ bool GearlynxCore::RunToVBlankTemplate(u8* frame_buffer, s16* sample_buffer,
         }
         while (!stop);
 
+        EndInputFrame();
+
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
         m_suzy->EndSpriteBoundingBoxFrame();
 #endif
+        m_suzy->EndFrame();
         if (render)
-            m_mikey->GetLcdScreen()->EndFrame(m_media->GetRotation());
+            EndLcdFrame(profile);
         m_audio->EndFrame(sample_buffer, sample_count);
+        if (profile)
+            m_frame_profile.frames++;
 
         return false;
     }
@@ -275,12 +342,102 @@ bool GearlynxCore::RunToVBlank(u8* frame_buffer, s16* sample_buffer,
         return RunToVBlankTemplate<false>(frame_buffer, sample_buffer, sample_count, debug, render);
 }
 
+void GearlynxCore::EndLcdFrame(bool profile)
+{
+    if (!profile)
+    {
+        m_mikey->GetLcdScreen()->EndFrame(m_media->GetRotation());
+        return;
+    }
+
+    u64 start = profile_clock_ns();
+    m_mikey->GetLcdScreen()->EndFrame(m_media->GetRotation());
+    m_frame_profile.lcd_ns += profile_clock_ns() - start;
+}
+
+void GearlynxCore::SetFrameProfileEnabled(bool enabled)
+{
+    m_frame_profile_enabled = enabled;
+}
+
+const GLYNX_Frame_Profile* GearlynxCore::GetFrameProfile()
+{
+    return &m_frame_profile;
+}
+
+void GearlynxCore::ResetFrameProfile()
+{
+    m_frame_profile.frames = 0;
+    m_frame_profile.cpu_ns = 0;
+    m_frame_profile.suzy_ns = 0;
+    m_frame_profile.mikey_ns = 0;
+    m_frame_profile.audio_ns = 0;
+    m_frame_profile.lcd_ns = 0;
+#if defined(GLYNX_PROFILE)
+    m_frame_profile.components = true;
+#else
+    m_frame_profile.components = false;
+#endif
+}
+
 void GearlynxCore::RenderFrameBuffer(u8* frame_buffer)
 {
     m_mikey->GetLcdScreen()->SetBuffer(frame_buffer);
     m_mikey->GetLcdScreen()->EndFrame(m_media->GetRotation());
 }
 
+void GearlynxCore::SetInputPollCallback(GLYNX_Input_Poll_Callback callback, void* user_data)
+{
+    m_input_poll_callback = callback;
+    m_input_poll_user_data = user_data;
+}
+
+const GLYNX_Input_Poll_Stats* GearlynxCore::GetInputPollStats()
+{
+    return &m_input_poll_stats;
+}
+
+void GearlynxCore::ResetInputPollStats()
+{
+    m_input_poll_stats.frames = 0;
+    m_input_poll_stats.polled_frames = 0;
+    m_input_poll_stats.min_line = 0xFFFFFFFF;
+    m_input_poll_stats.max_line = 0;
+    m_input_poll_stats.line_sum = 0;
+    m_input_poll_stats.last_line = 0;
+}
+
+void GearlynxCore::InputPoll(void* user_data)
+{
+    GearlynxCore* core = (GearlynxCore*)user_data;
+
+    // Lines are counted from the start of visible line 0, where frames begin
+    Mikey::Mikey_State* mikey_state = core->m_mikey->GetState();
+    int backup = mikey_state->timers[2].backup;
+    int counter = mikey_state->timers[2].counter;
+    int first_visible_counter = (backup >= 104) ? 102 : (backup - 2);
+    int lines = backup + 1;
+    core->m_input_poll_line = (u32)(((first_visible_counter - counter) % lines + lines) % lines);
+
+    if (IsValidPointer(core->m_input_poll_callback))
+        core->m_input_poll_callback(core->m_input_poll_user_data);
+}
+
+void GearlynxCore::EndInputFrame()
+{
+    m_input_poll_stats.frames++;
+
+    if (!m_input->EndFrame())
+        return;
+
+    u32 line = m_input_poll_line;
+    m_input_poll_stats.polled_frames++;
+    m_input_poll_stats.min_line = MIN(m_input_poll_stats.min_line, line);
+    m_input_poll_stats.max_line = MAX(m_input_poll_stats.max_line, line);
+    m_input_poll_stats.line_sum += line;
+    m_input_poll_stats.last_line = line;
+}
+
 bool GearlynxCore::LoadROM(const char* file_path)
 {
     if (m_media->LoadFromFile(file_path))
@@ -343,6 +500,8 @@ bool GearlynxCore::GetRuntimeInfo(GLYNX_Runtime_Info& runtime_info)
     float tick_T0_us = (float)k_mikey_timer_period_us[t0_prescaler];
 
     runtime_info.frame_time = ((t0_backup + 1.0f) * tick_T0_us * (t2_backup + 1.0f)) / 1000.0f;
+    runtime_info.collision_reads = m_suzy->GetFrameCollisionReads();
+    runtime_info.collision_writes = m_suzy->GetFrameCollisionWrites();
 
     return m_media->IsReady();
 }
@@ -745,14 +904,16 @@ bool GearlynxCore::SaveState(std::ostream& stream, size_t& size, bool screenshot
             header.screenshot_width = runtime_info.screen_width;
             header.screenshot_height = runtime_info.screen_height;
 
-            int bytes_per_pixel = 2;
-            if (m_mikey->GetLcdScreen()->GetPixelFormat() == GLYNX_PIXEL_RGBA8888)
-                bytes_per_pixel = 4;
+            LcdScreen* lcd_screen = m_mikey->GetLcdScreen();
+            int bytes_per_pixel = lcd_screen->GetBytesPerPixel();
+            int line_bytes = header.screenshot_width * bytes_per_pixel;
+            int pitch = lcd_screen->GetPitch() > 0 ? lcd_screen->GetPitch() : line_bytes;
 
-            u8* frame_buffer = m_mikey->GetLcdScreen()->GetBuffer();
+            u8* frame_buffer = lcd_screen->GetBuffer();
 
-            header.screenshot_size = header.screenshot_width * header.screenshot_height * bytes_per_pixel;
-            stream.write(reinterpret_cast<const char*>(frame_buffer), header.screenshot_size);
+            header.screenshot_size = line_bytes * header.screenshot_height;
+            for (u32 y = 0; y < header.screenshot_height; y++)
+                stream.write(reinterpret_cast<const char*>(frame_buffer + (y * pitch)), line_bytes);
         }
     }
     else
@@ -1075,6 +1236,7 @@ void GearlynxCore::Reset()
     m_audio->Reset(is_lynx2);
     m_bus->Reset();
     m_input->Reset();
+    ResetInputPollStats();
 
     m_comlynx_sync_cycles = m_mikey->GetComLynxSyncCycles();
 
@@ -100,6 +100,12 @@ public:
     bool IsComLynxCableConnected() const;
     u64 GetComLynxCycle() const;
     void RenderFrameBuffer(u8* frame_buffer);
+    void SetInputPollCallback(GLYNX_Input_Poll_Callback callback, void* user_data);
+    const GLYNX_Input_Poll_Stats* GetInputPollStats();
+    void ResetInputPollStats();
+    void SetFrameProfileEnabled(bool enabled);
+    const GLYNX_Frame_Profile* GetFrameProfile();
+    void ResetFrameProfile();
 
 private:
     void Reset();
@@ -110,6 +116,9 @@ private:
     bool LoadState(std::istream& stream);
     std::string GetSaveStatePath(const char* path, int index);
     void SynchronizeComLynx();
+    void EndInputFrame();
+    void EndLcdFrame(bool profile);
+    static void InputPoll(void* user_data);
 
 private:
     Memory* m_memory;
@@ -128,6 +137,12 @@ private:
     void* m_comlynx_sync_user_data;
     u64 m_comlynx_next_sync_cycle;
     u32 m_comlynx_sync_cycles;
+    GLYNX_Input_Poll_Callback m_input_poll_callback;
+    void* m_input_poll_user_data;
+    GLYNX_Input_Poll_Stats m_input_poll_stats;
+    u32 m_input_poll_line;
+    bool m_frame_profile_enabled;
+    GLYNX_Frame_Profile m_frame_profile;
 };
 
 #include "gearlynx_core_inline.h"
@@ -35,7 +35,7 @@ INLINE void GearlynxCore::SynchronizeComLynx()
 
     u32 sync_cycles = m_mikey->GetComLynxSyncCycles();
 
-    if (m_comlynx_sync_callback && (m_total_cycles >= m_comlynx_next_sync_cycle || sync_cycles != m_comlynx_sync_cycles))
+    if (m_total_cycles >= m_comlynx_next_sync_cycle || sync_cycles != m_comlynx_sync_cycles)
     {
         m_comlynx_sync_callback(m_mikey->GetComLynxCycle(), m_mikey->GetComLynxPromiseCycles(), m_comlynx_sync_user_data);
         m_comlynx_sync_cycles = sync_cycles;
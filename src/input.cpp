@@ -25,7 +25,10 @@ Input::Input(Media* media)
 {
     m_media = media;
     InitPointer(m_suzy);
+    InitPointer(m_poll_callback);
+    InitPointer(m_poll_user_data);
     m_state = 0x0000;
+    m_polled = false;
 }
 
 void Input::Init(Suzy* suzy)
@@ -37,6 +40,13 @@ void Input::Init(Suzy* suzy)
 void Input::Reset()
 {
     m_state = 0x0000;
+    m_polled = false;
+}
+
+void Input::SetPollCallback(GLYNX_Input_Poll_Callback callback, void* user_data)
+{
+    m_poll_callback = callback;
+    m_poll_user_data = user_data;
 }
 
 void Input::SaveState(std::ostream& stream)
@@ -49,6 +59,7 @@ void Input::LoadState(std::istream& stream)
 {
     StateSerializer serializer(stream);
     Serialize(serializer);
+    m_polled = false;
 }
 
 void Input::Serialize(StateSerializer& s)
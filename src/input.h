@@ -41,6 +41,9 @@ public:
     u8 ReadSwitches();
     void WriteJoystick(u8 value);
     void WriteSwitches(u8 value);
+    void SetPollCallback(GLYNX_Input_Poll_Callback callback, void* user_data);
+    void Poll();
+    bool EndFrame();
     void SaveState(std::ostream& stream);
     void LoadState(std::istream& stream);
 
@@ -52,6 +55,9 @@ private:
     Media* m_media;
     Suzy* m_suzy;
     u16 m_state;
+    GLYNX_Input_Poll_Callback m_poll_callback;
+    void* m_poll_user_data;
+    bool m_polled;
 };
 
 #include "input_inline.h"
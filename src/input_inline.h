@@ -136,4 +136,24 @@ INLINE void Input::WriteSwitches(u8 value)
     m_state = (m_state & 0x00FF) | ((u16)value << 8);
 }
 
+// The callback runs on the first JOYSTICK or SWITCHES read of each frame
+// so the frontend can latch input as late as the game allows
+INLINE void Input::Poll()
+{
+    if (m_polled)
+        return;
+
+    m_polled = true;
+
+    if (IsValidPointer(m_poll_callback))
+        m_poll_callback(m_poll_user_data);
+}
+
+INLINE bool Input::EndFrame()
+{
+    bool polled = m_polled;
+    m_polled = false;
+    return polled;
+}
+
 #endif /* INPUT_INLINE_H */
\ No newline at end of file
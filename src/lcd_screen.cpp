@@ -24,49 +24,105 @@
 #include "no_bios.h"
 #include "no_power.h"
 
+static inline bool IsLineRangeDirty(const u32* lines, int first, int last)
+{
+    for (int y = first; y < last; ++y)
+    {
+        if (lines[y >> 5] & (1u << (y & 31)))
+            return true;
+    }
+    return false;
+}
+
 template<typename Pixel, GLYNX_Rotation rotation>
 static void ConvertAndRotateFrameBuffer(const u16* src, Pixel* dst,
-    const Pixel* palette)
+    const Pixel* palette, int stride, const u32* lines)
 {
     const int width = GLYNX_SCREEN_WIDTH;
     const int height = GLYNX_SCREEN_HEIGHT;
-    const int pixel_count = width * height;
 
     if (rotation == GLYNX_ROTATION_180)
     {
-        for (int i = 0; i < pixel_count; ++i)
-            dst[pixel_count - 1 - i] = palette[src[i] & 0x0FFF];
+        for (int y = 0; y < height; ++y)
+        {
+            if (IsValidPointer(lines) && !IsLineRangeDirty(lines, y, y + 1))
+                continue;
+
+            const u16* src_line = src + (y * width);
+            Pixel* dst_line = dst + ((height - 1 - y) * stride) + (width - 1);
+            for (int x = 0; x < width; ++x)
+                dst_line[-x] = palette[src_line[x] & 0x0FFF];
+        }
         return;
     }
 
-    for (int y = 0; y < height; ++y)
+    // Rotate in 8x8 tiles so both the source rows and the destination
+    // rows being written stay in cache
+    const int tile = 8;
+
+    for (int y0 = 0; y0 < height; y0 += tile)
     {
-        for (int x = 0; x < width; ++x)
+        const int y1 = MIN(y0 + tile, height);
+
+        if (IsValidPointer(lines) && !IsLineRangeDirty(lines, y0, y1))
+            continue;
+
+        for (int x0 = 0; x0 < width; x0 += tile)
         {
-            const int src_index = y * width + x;
-            const int dst_index = (rotation == GLYNX_ROTATION_LEFT)
-                                  ? (width - 1 - x) * height + y
-                                  : x * height + (height - 1 - y);
-            dst[dst_index] = palette[src[src_index] & 0x0FFF];
+            const int x1 = MIN(x0 + tile, width);
+
+            for (int x = x0; x < x1; ++x)
+            {
+                const u16* src_column = src + x;
+
+                if (rotation == GLYNX_ROTATION_LEFT)
+                {
+                    Pixel* dst_line = dst + ((width - 1 - x) * stride);
+                    for (int y = y0; y < y1; ++y)
+                        dst_line[y] = palette[src_column[y * width] & 0x0FFF];
+                }
+                else
+                {
+                    Pixel* dst_line = dst + (x * stride) + (height - 1);
+                    for (int y = y0; y < y1; ++y)
+                        dst_line[-y] = palette[src_column[y * width] & 0x0FFF];
+                }
+            }
         }
     }
 }
 
 template<typename Pixel>
-static void ConvertRotatedFrameBuffer(const u16* src, Pixel* dst,
-    const Pixel* palette, GLYNX_Rotation rotation)
+static void ConvertFrameBuffer(const u16* src, Pixel* dst,
+    const Pixel* palette, GLYNX_Rotation rotation, int pitch, const u32* lines)
 {
+    bool rotated = (rotation == GLYNX_ROTATION_LEFT) || (rotation == GLYNX_ROTATION_RIGHT);
+    int line_width = rotated ? GLYNX_SCREEN_HEIGHT : GLYNX_SCREEN_WIDTH;
+    int stride = (pitch > 0) ? (pitch / (int)sizeof(Pixel)) : line_width;
+
     switch (rotation)
     {
+        case GLYNX_ROTATION_DISABLED:
+            for (int y = 0; y < GLYNX_SCREEN_HEIGHT; ++y)
+            {
+                if (IsValidPointer(lines) && !IsLineRangeDirty(lines, y, y + 1))
+                    continue;
+
+                const u16* src_line = src + (y * GLYNX_SCREEN_WIDTH);
+                Pixel* dst_line = dst + (y * stride);
+                for (int x = 0; x < GLYNX_SCREEN_WIDTH; ++x)
+                    dst_line[x] = palette[src_line[x] & 0x0FFF];
+            }
+            break;
         case GLYNX_ROTATION_LEFT:
-            ConvertAndRotateFrameBuffer<Pixel, GLYNX_ROTATION_LEFT>(src, dst, palette);
+            ConvertAndRotateFrameBuffer<Pixel, GLYNX_ROTATION_LEFT>(src, dst, palette, stride, lines);
             break;
         case GLYNX_ROTATION_180:
-            ConvertAndRotateFrameBuffer<Pixel, GLYNX_ROTATION_180>(src, dst, palette);
+            ConvertAndRotateFrameBuffer<Pixel, GLYNX_ROTATION_180>(src, dst, palette, stride, lines);
             break;
         case GLYNX_ROTATION_RIGHT:
         default:
-            ConvertAndRotateFrameBuffer<Pixel, GLYNX_ROTATION_RIGHT>(src, dst, palette);
+            ConvertAndRotateFrameBuffer<Pixel, GLYNX_ROTATION_RIGHT>(src, dst, palette, stride, lines);
             break;
     }
 }
@@ -79,6 +135,14 @@ LcdScreen::LcdScreen(Mikey* mikey, Memory* memory, Bus* bus)
     m_ram = m_memory->GetRAM();
     InitPointer(m_frame_buffer);
     m_pixel_format = GLYNX_PIXEL_RGBA8888;
+    m_pitch = 0;
+    m_dirty_line_conversion = false;
+    InitPointer(m_converted_buffer);
+    m_converted_pitch = 0;
+    m_converted_rotation = GLYNX_ROTATION_DISABLED;
+    memset(m_pending_dirty_lines, 0, sizeof(m_pending_dirty_lines));
+    memset(m_dirty_lines, 0, sizeof(m_dirty_lines));
+    m_skip_pixels = false;
     Reset();
 }
 
@@ -97,10 +161,15 @@ void LcdScreen::Reset()
 {
     memset(m_screen_buffer, 0, sizeof(m_screen_buffer));
     memset(&m_state, 0, sizeof(m_state));
+    memset(m_deferred_lines, 0, sizeof(m_deferred_lines));
+    m_line_deferred = false;
+    InvalidateFrame();
 }
 
 void LcdScreen::InitPalettes()
 {
+    InvalidateFrame();
+
     for (int i = 0; i < 4096; ++i)
     {
         u8 green = ((i >> 8) & 0x0F) * 255 / 15;
@@ -119,62 +188,172 @@ void LcdScreen::InitPalettes()
         u16 rgb565 = (red << 11) | (green << 5) | blue;
 
         m_rgb565_palette[i] = rgb565;
+
+        green = ((i >> 8) & 0x0F) * 255 / 15;
+        blue = ((i >> 4) & 0x0F) * 255 / 15;
+        red = (i & 0x0F) * 255 / 15;
+
+        switch (m_pixel_format)
+        {
+            case GLYNX_PIXEL_BGRA8888:
+                #ifdef GLYNX_LITTLE_ENDIAN
+                m_output_palette32[i] = (u32)blue | ((u32)green << 8) | ((u32)red << 16) | ((u32)255 << 24);
+                #else
+                m_output_palette32[i] = ((u32)255) | ((u32)red << 8) | ((u32)green << 16) | ((u32)blue << 24);
+                #endif
+                break;
+            case GLYNX_PIXEL_XRGB8888:
+                m_output_palette32[i] = ((u32)255 << 24) | ((u32)red << 16) | ((u32)green << 8) | (u32)blue;
+                break;
+            case GLYNX_PIXEL_RGB555:
+                m_output_palette16[i] = (u16)((((i & 0x0F) * 31 / 15) << 10) |
+                    ((((i >> 8) & 0x0F) * 31 / 15) << 5) | (((i >> 4) & 0x0F) * 31 / 15));
+                break;
+            case GLYNX_PIXEL_INDEXED12:
+                m_output_palette16[i] = (u16)i;
+                break;
+            case GLYNX_PIXEL_RGB565:
+                m_output_palette16[i] = rgb565;
+                break;
+            case GLYNX_PIXEL_RGBA8888:
+            default:
+                m_output_palette32[i] = m_rgba8888_palette[i];
+                break;
+        }
     }
 }
 
 void LcdScreen::EndFrame(GLYNX_Rotation rotation)
 {
-    u16* src = m_screen_buffer;
-    const int pixel_count = GLYNX_SCREEN_WIDTH * GLYNX_SCREEN_HEIGHT;
+    ResolveDeferredPixels();
 
-    if (m_pixel_format == GLYNX_PIXEL_RGB565)
-    {
-        u16* dst = (u16*)m_frame_buffer;
+    // Only lines that changed since the last conversion into this same
+    // buffer are converted again, anything else redraws the whole frame
+    bool partial = m_dirty_line_conversion && (m_converted_buffer == m_frame_buffer) &&
+        (m_converted_pitch == m_pitch) && (m_converted_rotation == rotation);
 
-        if (rotation == GLYNX_ROTATION_DISABLED)
-        {
-            for (int i = 0; i < pixel_count; ++i)
-            {
-                u16 color_12bit = src[i] & 0x0FFF;
-                dst[i] = m_rgb565_palette[color_12bit];
-            }
-            return;
-        }
+    if (partial)
+        memcpy(m_dirty_lines, m_pending_dirty_lines, sizeof(m_dirty_lines));
+    else
+        SetAllLinesDirty(m_dirty_lines);
 
-        ConvertRotatedFrameBuffer(src, dst, m_rgb565_palette,
-            rotation);
-    }
+    memset(m_pending_dirty_lines, 0, sizeof(m_pending_dirty_lines));
+    m_converted_buffer = m_frame_buffer;
+    m_converted_pitch = m_pitch;
+    m_converted_rotation = rotation;
+
+    const u32* lines = partial ? m_dirty_lines : NULL;
+
+    if (GetBytesPerPixel() == 2)
+        ConvertFrameBuffer(m_screen_buffer, (u16*)m_frame_buffer, m_output_palette16, rotation, m_pitch, lines);
     else
+        ConvertFrameBuffer(m_screen_buffer, (u32*)m_frame_buffer, m_output_palette32, rotation, m_pitch, lines);
+}
+
+// Decodes a skipped line from video RAM with the palette it started with.
+// Mid-line palette writes and later changes to the displayed RAM are not
+// seen, which is fine for frames nobody looked at.
+void LcdScreen::ResolveDeferredLine(u32 line)
+{
+    u16* dst = &m_screen_buffer[line * GLYNX_SCREEN_WIDTH];
+    const u16* palette = m_deferred_palettes[line];
+    u16 address = m_deferred_addresses[line];
+    bool enabled = m_deferred_enabled[line];
+    bool changed = false;
+
+    for (int i = 0; i < GLYNX_SCREEN_WIDTH; i += 2)
     {
-        u32* dst = (u32*)m_frame_buffer;
+        u8 src_byte = enabled ? m_ram[(u16)(address + (i >> 1))] : 0;
+        u16 left = palette[src_byte >> 4];
+        u16 right = palette[src_byte & 0x0F];
 
-        if (rotation == GLYNX_ROTATION_DISABLED)
+        if (dst[i] != left || dst[i + 1] != right)
         {
-            for (int i = 0; i < pixel_count; ++i)
-            {
-                u16 color_12bit = src[i] & 0x0FFF;
-                dst[i] = m_rgba8888_palette[color_12bit];
-            }
-            return;
+            dst[i] = left;
+            dst[i + 1] = right;
+            changed = true;
         }
+    }
+
+    if (changed)
+        MarkLineDirty(line);
+
+    m_deferred_lines[line >> 5] &= ~(1u << (line & 31));
+}
 
-        ConvertRotatedFrameBuffer(src, dst, m_rgba8888_palette,
-            rotation);
+void LcdScreen::ResolveDeferredPixels()
+{
+    for (int i = 0; i < GLYNX_SCREEN_DIRTY_WORDS; i++)
+    {
+        while (m_deferred_lines[i] != 0)
+        {
+            u32 bits = m_deferred_lines[i];
+            u32 bit = 0;
+            while (!(bits & (1u << bit)))
+                bit++;
+            ResolveDeferredLine((i << 5) + bit);
+        }
     }
 }
 
+void LcdScreen::InvalidateFrame()
+{
+    InitPointer(m_converted_buffer);
+}
+
+void LcdScreen::SetAllLinesDirty(u32* lines)
+{
+    memset(lines, 0xFF, GLYNX_SCREEN_DIRTY_WORDS * sizeof(u32));
+    lines[GLYNX_SCREEN_DIRTY_WORDS - 1] = 0xFFFFFFFF >> ((GLYNX_SCREEN_DIRTY_WORDS * 32) - GLYNX_SCREEN_HEIGHT);
+}
+
 void LcdScreen::RenderNoBiosScreen(u8* frame_buffer)
 {
-    int byte_count = GLYNX_SCREEN_WIDTH * GLYNX_SCREEN_HEIGHT * (m_pixel_format == GLYNX_PIXEL_RGB565 ? 2 : 4);
-    u8* no_bios_image = (m_pixel_format == GLYNX_PIXEL_RGB565) ? (u8*)k_no_bios_rgb565 : (u8*)k_no_bios_rgba8888;
-    memcpy(frame_buffer, no_bios_image, byte_count);
+    RenderImage(k_no_bios_rgba8888, k_no_bios_rgb565, frame_buffer);
 }
 
 void LcdScreen::RenderNoPowerScreen(u8* frame_buffer)
 {
-    int byte_count = GLYNX_SCREEN_WIDTH * GLYNX_SCREEN_HEIGHT * (m_pixel_format == GLYNX_PIXEL_RGB565 ? 2 : 4);
-    u8* no_power_image = (m_pixel_format == GLYNX_PIXEL_RGB565) ? (u8*)k_no_power_rgb565 : (u8*)k_no_power_rgba8888;
-    memcpy(frame_buffer, no_power_image, byte_count);
+    RenderImage(k_no_power_rgba8888, k_no_power_rgb565, frame_buffer);
+}
+
+void LcdScreen::RenderImage(const u8* rgba8888_image, const u8* rgb565_image, u8* frame_buffer)
+{
+    InvalidateFrame();
+    SetAllLinesDirty(m_dirty_lines);
+
+    int bytes_per_pixel = GetBytesPerPixel();
+    int line_bytes = GLYNX_SCREEN_WIDTH * bytes_per_pixel;
+    int pitch = (m_pitch > 0) ? m_pitch : line_bytes;
+
+    if (m_pixel_format == GLYNX_PIXEL_RGBA8888 || m_pixel_format == GLYNX_PIXEL_RGB565)
+    {
+        const u8* image = (m_pixel_format == GLYNX_PIXEL_RGB565) ? rgb565_image : rgba8888_image;
+        for (int y = 0; y < GLYNX_SCREEN_HEIGHT; y++)
+            memcpy(frame_buffer + (y * pitch), image + (y * line_bytes), line_bytes);
+        return;
+    }
+
+    // Other formats go back through the 12-bit palette, the images only
+    // use colors the Lynx can display
+    for (int y = 0; y < GLYNX_SCREEN_HEIGHT; y++)
+    {
+        const u8* src = rgba8888_image + (y * GLYNX_SCREEN_WIDTH * 4);
+        u8* dst = frame_buffer + (y * pitch);
+
+        for (int x = 0; x < GLYNX_SCREEN_WIDTH; x++)
+        {
+            u16 red = (u16)((src[x * 4 + 0] + 8) / 17);
+            u16 green = (u16)((src[x * 4 + 1] + 8) / 17);
+            u16 blue = (u16)((src[x * 4 + 2] + 8) / 17);
+            u16 color = (u16)((green << 8) | (blue << 4) | red);
+
+            if (bytes_per_pixel == 2)
+                ((u16*)dst)[x] = m_output_palette16[color];
+            else
+                ((u32*)dst)[x] = m_output_palette32[color];
+        }
+    }
 }
 
 void LcdScreen::SaveState(std::ostream& stream)
@@ -187,6 +366,9 @@ void LcdScreen::LoadState(std::istream& stream)
 {
     StateSerializer serializer(stream);
     Serialize(serializer);
+    InvalidateFrame();
+    memset(m_deferred_lines, 0, sizeof(m_deferred_lines));
+    m_line_deferred = false;
 
     if (m_state.line_dst_offset >= GLYNX_SCREEN_WIDTH * GLYNX_SCREEN_HEIGHT)
         m_state.line_dst_offset = 0;
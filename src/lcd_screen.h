@@ -65,11 +65,19 @@ public:
     void ConfigureLineTiming();
     void UpdatePalette(int index, u16 color);
     void EndFrame(GLYNX_Rotation rotation);
+    void SetSkipPixels(bool skip);
+    void SetDirtyLineConversion(bool enabled);
+    void InvalidateFrame();
+    const u32* GetDirtyLines();
+    bool IsFrameDirty();
     void SetBuffer(u8* frame_buffer);
     u8* GetBuffer();
+    void SetPitch(int pitch);
+    int GetPitch();
     u32* GetRGBA8888Palette();
     u16* GetRGB565Palette();
     GLYNX_Pixel_Format GetPixelFormat();
+    int GetBytesPerPixel();
     void RenderNoBiosScreen(u8* frame_buffer);
     void RenderNoPowerScreen(u8* frame_buffer);
     void SetVBlank(bool vblank);
@@ -79,8 +87,14 @@ public:
 
 private:
     void InitPalettes();
+    void RenderImage(const u8* rgba8888_image, const u8* rgb565_image, u8* frame_buffer);
+    void MarkLineDirty(u32 line);
+    void SetAllLinesDirty(u32* lines);
     void DoDMA();
     void DrawPixel();
+    void SkipPixels(u32 count);
+    void ResolveDeferredLine(u32 line);
+    void ResolveDeferredPixels();
     void Serialize(StateSerializer& s);
 
 private:
@@ -92,8 +106,23 @@ private:
     u16 m_screen_buffer[GLYNX_SCREEN_WIDTH * GLYNX_SCREEN_HEIGHT] = {};
     LcdScreen_State m_state;
     GLYNX_Pixel_Format m_pixel_format;
+    int m_pitch;
     u32 m_rgba8888_palette[4096] = {};
     u16 m_rgb565_palette[4096] = {};
+    u32 m_output_palette32[4096] = {};
+    u16 m_output_palette16[4096] = {};
+    u32 m_pending_dirty_lines[GLYNX_SCREEN_DIRTY_WORDS];
+    u32 m_dirty_lines[GLYNX_SCREEN_DIRTY_WORDS];
+    bool m_dirty_line_conversion;
+    u8* m_converted_buffer;
+    int m_converted_pitch;
+    GLYNX_Rotation m_converted_rotation;
+    bool m_skip_pixels;
+    bool m_line_deferred;
+    u32 m_deferred_lines[GLYNX_SCREEN_DIRTY_WORDS];
+    u16 m_deferred_addresses[GLYNX_SCREEN_HEIGHT];
+    bool m_deferred_enabled[GLYNX_SCREEN_HEIGHT];
+    u16 m_deferred_palettes[GLYNX_SCREEN_HEIGHT][16];
 };
 
 static const u32 k_pixel_spacing_cycles = 12;
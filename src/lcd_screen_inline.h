@@ -35,10 +35,23 @@ INLINE void LcdScreen::Update(u32 cycles)
     if (m_state.dma_burst_count >= k_dma_bursts_per_line && m_state.pixel_count >= GLYNX_SCREEN_WIDTH)
         return;
 
-    while (m_state.pixel_count < GLYNX_SCREEN_WIDTH && m_state.pixel_next_at <= m_state.current_cycle)
+    if (unlikely(m_line_deferred))
     {
-        DrawPixel();
-        m_state.pixel_next_at += k_pixel_spacing_cycles;
+        if (m_state.pixel_count < GLYNX_SCREEN_WIDTH && m_state.pixel_next_at <= m_state.current_cycle)
+        {
+            u32 due = ((m_state.current_cycle - m_state.pixel_next_at) / k_pixel_spacing_cycles) + 1;
+            due = MIN(due, GLYNX_SCREEN_WIDTH - m_state.pixel_count);
+            SkipPixels(due);
+            m_state.pixel_next_at += due * k_pixel_spacing_cycles;
+        }
+    }
+    else
+    {
+        while (m_state.pixel_count < GLYNX_SCREEN_WIDTH && m_state.pixel_next_at <= m_state.current_cycle)
+        {
+            DrawPixel();
+            m_state.pixel_next_at += k_pixel_spacing_cycles;
+        }
     }
 
     while (m_state.dma_burst_count < k_dma_bursts_per_line && m_state.dma_next_at <= m_state.current_cycle)
@@ -56,6 +69,21 @@ INLINE void LcdScreen::ResetLine(u32 cycles)
 
 INLINE void LcdScreen::ResetVisibleLine(u8 line)
 {
+    u32 line_bit = 1u << (line & 31);
+
+    // Skipped lines only remember where their pixels come from. The last
+    // burst already fetched their first 8 bytes, right before the DMA source
+    if (m_skip_pixels)
+    {
+        m_deferred_lines[line >> 5] |= line_bit;
+        m_deferred_addresses[line] = (u16)(m_state.dma_current_src_addr - 8);
+        m_deferred_enabled[line] = IS_SET_BIT(m_mikey->GetState()->DISPCTL, 0);
+        memcpy(m_deferred_palettes[line], m_state.current_palette, sizeof(m_state.current_palette));
+    }
+    else
+        m_deferred_lines[line >> 5] &= ~line_bit;
+
+    m_line_deferred = m_skip_pixels;
     m_state.current_line = line;
     m_state.dma_next_at = m_state.rendering_offset + 12;
     m_state.dma_burst_count = 0;
@@ -69,7 +97,20 @@ INLINE void LcdScreen::ResetVisibleLine(u8 line)
 INLINE void LcdScreen::ClearLine(u8 line)
 {
     u32 offset = line * GLYNX_SCREEN_WIDTH;
-    memset(&m_screen_buffer[offset], 0, GLYNX_SCREEN_WIDTH * sizeof(u16));
+
+    m_deferred_lines[line >> 5] &= ~(1u << (line & 31));
+    if (line == m_state.current_line)
+        m_line_deferred = false;
+
+    for (int i = 0; i < GLYNX_SCREEN_WIDTH; i++)
+    {
+        if (m_screen_buffer[offset + i] != 0)
+        {
+            MarkLineDirty(line);
+            memset(&m_screen_buffer[offset], 0, GLYNX_SCREEN_WIDTH * sizeof(u16));
+            break;
+        }
+    }
 }
 
 INLINE void LcdScreen::FinishLine()
@@ -77,10 +118,14 @@ INLINE void LcdScreen::FinishLine()
     if (m_state.in_vblank)
         return;
 
-    while (m_state.pixel_count < GLYNX_SCREEN_WIDTH)
+    if (unlikely(m_line_deferred))
     {
-        DrawPixel();
+        SkipPixels(GLYNX_SCREEN_WIDTH - m_state.pixel_count);
+        return;
     }
+
+    while (m_state.pixel_count < GLYNX_SCREEN_WIDTH)
+        DrawPixel();
 }
 
 INLINE void LcdScreen::FirstDMA()
@@ -106,6 +151,11 @@ INLINE void LcdScreen::UpdatePalette(int index, u16 color)
     m_state.current_palette[index] = color;
 }
 
+INLINE void LcdScreen::SetSkipPixels(bool skip)
+{
+    m_skip_pixels = skip;
+}
+
 INLINE void LcdScreen::SetBuffer(u8* frame_buffer)
 {
     m_frame_buffer = frame_buffer;
@@ -116,6 +166,16 @@ INLINE u8* LcdScreen::GetBuffer()
     return m_frame_buffer;
 }
 
+INLINE void LcdScreen::SetPitch(int pitch)
+{
+    m_pitch = pitch;
+}
+
+INLINE int LcdScreen::GetPitch()
+{
+    return m_pitch;
+}
+
 INLINE u32* LcdScreen::GetRGBA8888Palette()
 {
     return m_rgba8888_palette;
@@ -131,6 +191,19 @@ INLINE GLYNX_Pixel_Format LcdScreen::GetPixelFormat()
     return m_pixel_format;
 }
 
+INLINE int LcdScreen::GetBytesPerPixel()
+{
+    switch (m_pixel_format)
+    {
+        case GLYNX_PIXEL_RGB565:
+        case GLYNX_PIXEL_RGB555:
+        case GLYNX_PIXEL_INDEXED12:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
 INLINE void LcdScreen::SetVBlank(bool vblank)
 {
     m_state.in_vblank = vblank;
@@ -173,8 +246,44 @@ INLINE void LcdScreen::DrawPixel()
     m_state.pixel_buffer_read_pos = (m_state.pixel_buffer_read_pos + 1) & 0x1F;
 
     u16 color = m_state.current_palette[pen];
-    m_screen_buffer[m_state.line_dst_offset + m_state.pixel_count] = color;
+    u16* pixel = &m_screen_buffer[m_state.line_dst_offset + m_state.pixel_count];
+    if (*pixel != color)
+    {
+        *pixel = color;
+        MarkLineDirty(m_state.current_line);
+    }
     m_state.pixel_count++;
 }
 
+INLINE void LcdScreen::SkipPixels(u32 count)
+{
+    m_state.pixel_buffer_read_pos = (m_state.pixel_buffer_read_pos + count) & 0x1F;
+    m_state.pixel_count += count;
+}
+
+INLINE void LcdScreen::MarkLineDirty(u32 line)
+{
+    m_pending_dirty_lines[line >> 5] |= 1u << (line & 31);
+}
+
+INLINE void LcdScreen::SetDirtyLineConversion(bool enabled)
+{
+    m_dirty_line_conversion = enabled;
+}
+
+INLINE const u32* LcdScreen::GetDirtyLines()
+{
+    return m_dirty_lines;
+}
+
+INLINE bool LcdScreen::IsFrameDirty()
+{
+    for (int i = 0; i < GLYNX_SCREEN_DIRTY_WORDS; i++)
+    {
+        if (m_dirty_lines[i] != 0)
+            return true;
+    }
+    return false;
+}
+
 #endif /* LCD_SCREEN_INLINE_H */
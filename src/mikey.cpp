@@ -39,6 +39,13 @@ Mikey::Mikey(Suzy* suzy, Media* media, M6502* m6502, Bus* bus, Random* random)
     InitPointer(m_lcd_screen);
     InitPointer(m_trace_logger);
     m_debug_output_enabled = false;
+    m_audio_revision = 0;
+    for (int i = 0; i < 4; i++)
+        m_lfsr_table_mask[i] = 0xFFFF;
+    m_timer_passive_mask = 0;
+    for (int i = 0; i < 8; i++)
+        m_timer_passive_cycle[i] = 0;
+    m_analytic_timers = true;
     m_cpu_read_cycles = 0;
     m_comlynx_publish_callback = NULL;
     m_comlynx_sample_callback = NULL;
@@ -51,6 +58,8 @@ Mikey::Mikey(Suzy* suzy, Media* media, M6502* m6502, Bus* bus, Random* random)
     m_comlynx_cable_connected = false;
     m_comlynx_cycle = 0;
     m_uart_last_bit_cycle = 0;
+    m_uart_cycle = 0;
+    m_uart_sync_cycle = 0;
     m_uart_tx_wire_start = 0;
     m_uart_tx_wire_bit_cycles = 0;
     m_uart_tx_wire_bits = 0x07FF;
@@ -293,6 +302,8 @@ void Mikey::LogUARTEvent(u8 event, u8 data, u8 flags, u8 source,
     u8 lost, bool chained)
 {
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
+    SyncUART();
+
     if (event == TRACE_MIKEY_UART_IRQ)
     {
         bool level = data != 0;
@@ -377,6 +388,7 @@ void Mikey::LogUARTEvent(u8 event, u8 data, u8 flags, u8 source,
 void Mikey::LogUARTConfigEvent(u8 value, bool register_write)
 {
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
+    SyncUART();
     u8 config = value & 0xD7;
     bool reset_errors = register_write && IS_SET_BIT(value, 3);
     u8 backup = m_state.timers[4].backup;
@@ -626,6 +638,7 @@ void Mikey::ResetTimers()
     m_timer_status_mask = 0;
     m_timer_active_source_mask = 0;
     m_timer_source_countdown = 0;
+    m_timer_passive_mask = 0;
 
     for (int i = 0; i < 8; i++)
     {
@@ -646,6 +659,8 @@ void Mikey::ResetTimers()
 
 void Mikey::ResetAudio()
 {
+    m_audio_revision++;
+
     for (int i = 0; i < 4; i++)
     {
         m_state.audio[i].volume = 0;
@@ -662,6 +677,7 @@ void Mikey::ResetAudio()
         m_state.audio[i].internal_lfsr = 0;
         m_state.audio[i].internal_taps_mask = 0;
         m_state.audio[i].internal_mix = true;
+        RebuildLFSRTable(i);
     }
 
     m_state.MSTEREO = 0x00;
@@ -672,6 +688,170 @@ void Mikey::ResetAudio()
     m_state.ATTEN_D = 0x00;
 }
 
+void Mikey::RebuildLFSRTable(u8 channel)
+{
+    // Next state for every 12-bit LFSR value with the current taps, the
+    // shifted in bit (bit 0 of the next state) is the channel output bit
+    u16 mask = m_state.audio[channel].internal_taps_mask;
+    u16* next = m_lfsr_next[channel];
+
+    for (u32 lfsr = 0; lfsr < 4096; lfsr++)
+    {
+        u8 data_in = (u8)(parity16((u16)(lfsr & mask)) ^ 1u);
+        next[lfsr] = (u16)(((lfsr << 1) & 0x0FFE) | data_in);
+    }
+
+    m_lfsr_table_mask[channel] = mask;
+}
+
+void Mikey::SetAnalyticTimers(bool enabled)
+{
+    m_analytic_timers = enabled;
+    RebuildTimerPassiveMask();
+}
+
+void Mikey::RebuildTimerPassiveMask()
+{
+    // Timers nobody observes between register accesses are taken out of the
+    // source masks and caught up analytically when read or written:
+    // self-clocked, no IRQ, never stuck as done, not feeding video, UART or
+    // audio, and only linking into a disabled timer
+    SyncPassiveTimers();
+
+    u8 passive = 0;
+    bool trace_active = false;
+
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+    trace_active = IsValidPointer(m_trace_logger) &&
+        (m_trace_logger->IsEventEnabled(TRACE_MIKEY_TIMER, TRACE_MIKEY_TIMER_UNDERFLOW) ||
+        m_trace_logger->IsEventEnabled(TRACE_MIKEY_TIMER, TRACE_MIKEY_TIMER_LINK));
+#endif
+
+    for (int i = 0; i < 8 && m_analytic_timers && !trace_active; i++)
+    {
+        if (i == 0 || i == 2 || i == 4 || i == 7)
+            continue;
+
+        u8 control = m_state.timers[i].control_a;
+
+        if (IS_NOT_SET_BIT(control, 3) || (control & 0x07) == 7 || IS_SET_BIT(control, 7))
+            continue;
+        if (IS_NOT_SET_BIT(control, 4) && IS_NOT_SET_BIT(control, 6))
+            continue;
+
+        int link = k_mikey_timer_forward_links[i];
+        if (link >= 0 && IS_SET_BIT(m_state.timers[link].control_a, 3))
+            continue;
+
+        passive = SET_BIT(passive, i);
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+        u8 control = m_state.timers[i].control_a;
+        int prescaler = control & 0x07;
+
+        if (IS_NOT_SET_BIT(control, 3) || prescaler == 7)
+            continue;
+
+        if (IS_SET_BIT(passive, i))
+        {
+            m_timer_source_masks[prescaler] = UNSET_BIT(m_timer_source_masks[prescaler], i);
+            if (IS_NOT_SET_BIT(m_timer_passive_mask, i))
+                m_timer_passive_cycle[i] = m_comlynx_cycle;
+        }
+        else
+            m_timer_source_masks[prescaler] = SET_BIT(m_timer_source_masks[prescaler], i);
+    }
+
+    m_timer_passive_mask = passive;
+    m_timer_active_source_mask = 0;
+
+    for (int prescaler = 0; prescaler < 7; prescaler++)
+    {
+        if (m_timer_source_masks[prescaler] != 0)
+            m_timer_active_source_mask = SET_BIT(m_timer_active_source_mask, prescaler);
+    }
+}
+
+void Mikey::SyncPassiveTimer(int timer)
+{
+    u64 elapsed = m_comlynx_cycle - m_timer_passive_cycle[timer];
+    m_timer_passive_cycle[timer] = m_comlynx_cycle;
+
+    GLYNX_Mikey_Timer* t = &m_state.timers[timer];
+    int prescaler = t->control_a & 0x07;
+    u32 period = k_mikey_timer_period_cycles[prescaler];
+    u32 phase = m_state.timer_source_phase;
+    u32 start_phase = (phase - (u32)(elapsed & 1023)) & 1023;
+    u32 first = ((k_mikey_timer_source_phase[prescaler] - start_phase - 1) & (period - 1)) + 1;
+
+    if (elapsed < first)
+        return;
+
+    u64 ticks = 1 + ((elapsed - first) / period);
+    u32 age = (u32)((elapsed - first) % period);
+
+    // Counter walks down to 0 and borrows on the next tick, then restarts
+    // from backup (reload) or stays at 0 (one-shot with reset done)
+    u64 reload = IS_SET_BIT(t->control_a, 4) ? (u64)t->backup : 0;
+    u64 borrows = 0;
+    u64 since_borrow = 0;
+
+    if (ticks <= t->counter)
+        t->counter = (u8)(t->counter - ticks);
+    else
+    {
+        u64 after = ticks - t->counter - 1;
+        borrows = 1 + (after / (reload + 1));
+        since_borrow = after % (reload + 1);
+        t->counter = (u8)(reload - since_borrow);
+    }
+
+    bool last_borrow = (borrows > 0) && (since_borrow == 0);
+
+    if (IS_SET_BIT(t->control_a, 6))
+    {
+        t->control_b = UNSET_BIT(t->control_b, 3);
+        if (last_borrow)
+            t->control_b = SET_BIT(t->control_b, 3);
+    }
+    else if (borrows > 0)
+        t->control_b = SET_BIT(t->control_b, 3);
+
+    t->control_b &= 0xF8;
+    if (last_borrow)
+        t->control_b = SET_BIT(t->control_b, 2);
+
+    // Borrow flags expire when the phase reaches the timer's own slot
+    u32 tick_phase = (phase - age) & 1023;
+    if (age < ((timer - tick_phase) & 0x0F))
+    {
+        t->control_b = SET_BIT(t->control_b, 1);
+        if (last_borrow)
+            t->control_b = SET_BIT(t->control_b, 0);
+    }
+
+    UpdateTimerStatusMask(timer);
+
+    int link = k_mikey_timer_forward_links[timer];
+
+    if (borrows > 0 && link >= 0)
+    {
+        GLYNX_Mikey_Timer* target = &m_state.timers[link];
+        u64 borrow_age = (u64)age + (since_borrow * period);
+        u32 borrow_phase = (phase - (u32)(borrow_age & 1023)) & 1023;
+
+        target->internal_pending_ticks += (u32)borrows;
+
+        if (borrow_age < (u64)((link - borrow_phase) & 0x0F))
+        {
+            target->control_b = SET_BIT(target->control_b, 1);
+            m_timer_status_mask = SET_BIT(m_timer_status_mask, link);
+        }
+    }
+}
+
 void Mikey::RebuildTimerSourceDistances()
 {
     u8 key = m_timer_active_source_mask;
@@ -759,6 +939,7 @@ void Mikey::ResetUART()
     m_state.uart.tx_empty_cycles = 0;
     m_state.uart.tx_start_bits = 0;
     m_state.uart.rx_age_cycles = 0;
+    m_uart_sync_cycle = m_uart_cycle;
     m_uart_last_bit_cycle = 0;
     m_uart_tx_wire_start = 0;
     m_uart_tx_wire_bit_cycles = 0;
@@ -801,6 +982,8 @@ void Mikey::ResetPalette()
 void Mikey::HorizontalBlank()
 {
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
+    TraceRedEyeTimeoutEvent();
+
     if (!m_lcd_screen->GetState()->in_vblank)
         TraceDisplayEvent(TRACE_MIKEY_DISPLAY_DMA_LINE);
 #endif
@@ -927,6 +1110,8 @@ u64 Mikey::GetComLynxCycle() const
 
 void Mikey::SaveState(std::ostream& stream)
 {
+    SyncState();
+
     StateSerializer serializer(stream);
     Serialize(serializer, GLYNX_SAVESTATE_VERSION);
 
@@ -938,13 +1123,20 @@ void Mikey::LoadState(std::istream& stream, int version)
     StateSerializer serializer(stream);
     Serialize(serializer, version);
     m_cpu_read_cycles = 0;
+    m_uart_sync_cycle = m_uart_cycle;
     m_uart_tx_wire_start = 0;
     m_uart_tx_wire_bit_cycles = 0;
     m_uart_tx_wire_bits = 0x07FF;
     m_uart_tx_wire_published = false;
     m_uart_rx_wire_state = 0;
     m_uart_rx_wire_link = false;
+    m_audio_revision++;
     RebuildTimerCaches();
+    for (int i = 0; i < 4; i++)
+    {
+        if (m_lfsr_table_mask[i] != m_state.audio[i].internal_taps_mask)
+            RebuildLFSRTable(i);
+    }
 
     m_lcd_screen->LoadState(stream);
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
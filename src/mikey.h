@@ -89,6 +89,11 @@ public:
     template<bool debug = false> void Write(u16 address, u8 value);
     bool IsPoweredOn();
     Mikey_State* GetState();
+    void SyncState();
+    void SetAnalyticTimers(bool enabled);
+    u32 GetAudioRevision();
+    u16 GetLFSRStateAfter(u8 channel, u32 clocks);
+    void AdvanceLFSR(u8 channel, u32 clocks = 1);
     LcdScreen* GetLcdScreen();
     bool SwitchAudInValue();
     void SetSuzyDone();
@@ -132,10 +137,13 @@ private:
     void WriteAudioExtra(u16 address, u8 value, bool debug = false);
     void Advance(u32 cycles);
     void SynchronizeCPURead();
-    void UpdateUART(u32 cycles);
+    void SyncUART();
     void UpdateTimerHardware(u32 cycles);
     void ClockTimerDomain(int prescaler, u32 remaining_cycles);
     void RebuildTimerCaches();
+    void RebuildTimerPassiveMask();
+    void SyncPassiveTimers();
+    void SyncPassiveTimer(int timer);
     void UpdateTimerServiceMask(int unit);
     void UpdateTimerStatusMask(int unit);
     void ExpireTimerStatus(u32 phase, u32 cycles);
@@ -150,9 +158,9 @@ private:
     void ServiceAudio(int channel);
     bool BorrowInTimer(int i, GLYNX_Mikey_Timer* t);
     bool BorrowInChannel(int i, GLYNX_Mikey_Audio* c);
-    void AdvanceLFSR(u8 channel);
     void RebuildTapsMask(GLYNX_Mikey_Audio* channel);
     void RebuildLFSR(GLYNX_Mikey_Audio* channel);
+    void RebuildLFSRTable(u8 channel);
     void CalculateCutoff(u8 channel);
     void UpdateIRQs();
     void UartRelevelIRQ();
@@ -212,6 +220,9 @@ private:
     Mikey_State m_state;
     bool m_is_lynx2;
     bool m_debug_output_enabled;
+    u32 m_audio_revision;
+    u16 m_lfsr_next[4][4096];
+    u16 m_lfsr_table_mask[4];
     TraceLogger* m_trace_logger;
     u32 m_cpu_read_cycles;
     GLYNX_ComLynx_Publish_Callback m_comlynx_publish_callback;
@@ -222,6 +233,8 @@ private:
     bool m_comlynx_cable_connected;
     u64 m_comlynx_cycle;
     u64 m_uart_last_bit_cycle;
+    u64 m_uart_cycle;
+    u64 m_uart_sync_cycle;
     u64 m_uart_tx_wire_start;
     u32 m_uart_tx_wire_bit_cycles;
     u16 m_uart_tx_wire_bits;
@@ -249,6 +262,9 @@ private:
     u16 m_timer_source_distance[1024];
     u8 m_timer_source_key;
     u32 m_timer_source_countdown;
+    u8 m_timer_passive_mask;
+    u64 m_timer_passive_cycle[8];
+    bool m_analytic_timers;
 
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     struct RedEyeStream
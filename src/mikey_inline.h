@@ -156,6 +156,7 @@ INLINE u8 Mikey::Read(u16 address)
         }
         case MIKEY_SERCTL:        // 0xFD8C
         {
+            SyncUART();
             u8 status = 0;
             status |= (m_state.uart.tx_ready ? 0x80 : 0x00);
             status |= (m_state.uart.rx_ready ? 0x40 : 0x00);
@@ -345,6 +346,7 @@ INLINE void Mikey::Write(u16 address, u8 value)
         case MIKEY_SERCTL:        // 0xFD8C
         {
             DebugMikey("Setting SERCTL to %02X (was %02X)", value, m_state.SERCTL);
+            SyncUART();
             bool was_tx_brk = m_state.uart.tx_brk;
             bool was_break_asserted = m_state.uart.tx_open && m_state.uart.tx_brk;
 
@@ -413,6 +415,7 @@ INLINE void Mikey::Write(u16 address, u8 value)
         case MIKEY_SERDAT:        // 0xFD8D
         {
             DebugMikey("Setting SERDAT (TX) to %02X", value);
+            SyncUART();
 
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
             if (!debug)
@@ -540,6 +543,31 @@ INLINE Mikey::Mikey_State* Mikey::GetState()
     return &m_state;
 }
 
+// Passive timers and the UART idle counters lag behind until observed,
+// anyone inspecting the whole state from outside the core syncs first
+INLINE void Mikey::SyncState()
+{
+    SyncPassiveTimers();
+    SyncUART();
+}
+
+INLINE u32 Mikey::GetAudioRevision()
+{
+    return m_audio_revision;
+}
+
+// Walks the channel's next-state table, nothing is changed
+INLINE u16 Mikey::GetLFSRStateAfter(u8 channel, u32 clocks)
+{
+    const u16* next = m_lfsr_next[channel];
+    u16 lfsr = m_state.audio[channel].internal_lfsr & 0x0FFF;
+
+    while (clocks-- > 0)
+        lfsr = next[lfsr];
+
+    return lfsr;
+}
+
 INLINE bool Mikey::IsPoweredOn()
 {
     return IS_SET_BIT(m_state.SYSCTL1, 1);
@@ -639,6 +667,8 @@ inline u8 Mikey::ReadTimer(u16 address)
         SynchronizeCPURead();
     }
 
+    SyncPassiveTimers();
+
     GLYNX_Mikey_Timer* t = &m_state.timers[i];
 
     switch (reg)
@@ -674,6 +704,8 @@ inline void Mikey::WriteTimer(u16 address, u8 value)
         SynchronizeCPURead();
     }
 
+    SyncPassiveTimers();
+
     GLYNX_Mikey_Timer* t = &m_state.timers[i];
 
 #ifndef GLYNX_DISABLE_VGMRECORDER
@@ -740,6 +772,7 @@ inline void Mikey::WriteTimer(u16 address, u8 value)
             t->control_b = UNSET_BIT(t->control_b, 3);
 
         UpdateTimerServiceMask(i);
+        RebuildTimerPassiveMask();
         RebuildTimerSourceDistances();
         m_timer_source_countdown = CalculateNextTimerSourceCycles(m_state.timer_source_phase);
 
@@ -912,6 +945,8 @@ inline void Mikey::WriteAudio(u16 address, u8 value)
         break;
     }
 
+    m_audio_revision++;
+
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     if (!debug)
         TraceAudioEvent(TRACE_MIKEY_AUDIO_CHANNEL, i, (u8)reg, value);
@@ -982,6 +1017,8 @@ inline void Mikey::WriteAudioExtra(u16 address, u8 value, bool debug)
         break;
     }
 
+    m_audio_revision++;
+
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     if (!debug)
         TraceAudioEvent(TRACE_MIKEY_AUDIO_MIXER, 0xFF, (u8)(address & 0xFF), value);
@@ -991,27 +1028,36 @@ inline void Mikey::WriteAudioExtra(u16 address, u8 value, bool debug)
 INLINE void Mikey::Advance(u32 cycles)
 {
     UpdateVideo(cycles);
-    UpdateUART(cycles);
+    m_uart_cycle += cycles;
     UpdateTimerHardware(cycles);
     UpdateIRQs();
 }
 
-INLINE void Mikey::UpdateUART(u32 cycles)
+// RX age and the TX empty delay only matter when something looks at them,
+// so they catch up here from the end of the last advance instead of
+// being counted down on every advance
+INLINE void Mikey::SyncUART()
 {
-    TraceRedEyeTimeoutEvent();
+    u64 elapsed = m_uart_cycle - m_uart_sync_cycle;
+
+    if (elapsed == 0)
+        return;
+
+    m_uart_sync_cycle = m_uart_cycle;
 
     if (m_state.uart.rx_age_cycles < GLYNX_UART_RX_AGE_MAX_CYCLES)
-        m_state.uart.rx_age_cycles += cycles;
+        m_state.uart.rx_age_cycles = (u32)MIN((u64)m_state.uart.rx_age_cycles + elapsed,
+            (u64)GLYNX_UART_RX_AGE_MAX_CYCLES);
 
     if (m_state.uart.tx_empty_cycles > 0)
     {
-        if (cycles >= m_state.uart.tx_empty_cycles)
+        if (elapsed >= m_state.uart.tx_empty_cycles)
         {
             m_state.uart.tx_empty_cycles = 0;
             m_state.uart.tx_empty = true;
         }
         else
-            m_state.uart.tx_empty_cycles -= cycles;
+            m_state.uart.tx_empty_cycles -= (u8)elapsed;
     }
 }
 
@@ -1031,6 +1077,17 @@ INLINE void Mikey::UpdateTimerHardware(u32 cycles)
 {
     m_video_line_remainder = 0;
 
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+    if (unlikely(m_timer_passive_mask != 0) && IsValidPointer(m_trace_logger) &&
+        (m_trace_logger->IsEventEnabled(TRACE_MIKEY_TIMER, TRACE_MIKEY_TIMER_UNDERFLOW) ||
+        m_trace_logger->IsEventEnabled(TRACE_MIKEY_TIMER, TRACE_MIKEY_TIMER_LINK)))
+    {
+        RebuildTimerPassiveMask();
+        RebuildTimerSourceDistances();
+        m_timer_source_countdown = CalculateNextTimerSourceCycles(m_state.timer_source_phase);
+    }
+#endif
+
     while (cycles > 0)
     {
         bool turbo_sync = unlikely(m_comlynx_cable_connected &&
@@ -1230,6 +1287,18 @@ INLINE void Mikey::ClockTimerDomain(int prescaler, u32 remaining_cycles)
     }
 }
 
+INLINE void Mikey::SyncPassiveTimers()
+{
+    u8 mask = m_timer_passive_mask;
+
+    while (mask != 0)
+    {
+        int timer = (int)t_zero16(mask);
+        mask &= mask - 1;
+        SyncPassiveTimer(timer);
+    }
+}
+
 INLINE void Mikey::RebuildTimerCaches()
 {
     memset(m_timer_source_masks, 0, sizeof(m_timer_source_masks));
@@ -1266,6 +1335,8 @@ INLINE void Mikey::RebuildTimerCaches()
         UpdateTimerServiceMask(channel + 8);
     }
 
+    m_timer_passive_mask = 0;
+    RebuildTimerPassiveMask();
     RebuildTimerSourceDistances();
     m_timer_source_countdown = CalculateNextTimerSourceCycles(m_state.timer_source_phase);
 }
@@ -1401,6 +1472,8 @@ INLINE bool Mikey::BorrowInTimer(int i, GLYNX_Mikey_Timer* t)
         {
             if (link < 8)
             {
+                if (IS_SET_BIT(m_timer_passive_mask, link))
+                    SyncPassiveTimer(link);
                 m_state.timers[link].internal_pending_ticks++;
                 m_state.timers[link].control_b = SET_BIT(m_state.timers[link].control_b, 1);
                 m_timer_status_mask = SET_BIT(m_timer_status_mask, link);
@@ -1513,6 +1586,8 @@ INLINE bool Mikey::BorrowInChannel(int i, GLYNX_Mikey_Audio* c)
         }
         else // audio ch 3 links to timer 1
         {
+            if (IS_SET_BIT(m_timer_passive_mask, 1))
+                SyncPassiveTimer(1);
             m_state.timers[1].internal_pending_ticks++;
             m_state.timers[1].control_b = SET_BIT(m_state.timers[1].control_b, 1);
             m_timer_status_mask = SET_BIT(m_timer_status_mask, 1);
@@ -1535,34 +1610,44 @@ INLINE bool Mikey::BorrowInChannel(int i, GLYNX_Mikey_Audio* c)
     return true;
 }
 
-INLINE void Mikey::AdvanceLFSR(u8 channel)
+// Clocks the channel LFSR several times in one call. The output bit of
+// every clock is bit 0 of the state it shifts into, integrate mode needs
+// each of them because the accumulator saturates.
+INLINE void Mikey::AdvanceLFSR(u8 channel, u32 clocks)
 {
     GLYNX_Mikey_Audio* c = &m_state.audio[channel];
+    const u16* next = m_lfsr_next[channel];
 
-    s8 vol = (s8)c->volume;
-    u16 x = (u16)(c->internal_lfsr & c->internal_taps_mask);
-    u8 xorbit = parity16(x);
-    u8 data_in = (u8)(xorbit ^ 1u);
-
-    c->internal_lfsr = (u16)(((c->internal_lfsr << 1) & 0x0FFE) | (u16)data_in);
+    int vol = (int)(s8)c->volume;
+    u16 lfsr = c->internal_lfsr & 0x0FFF;
+    s8 previous_output = c->output;
 
     if (IS_SET_BIT(c->control, 5))
     {
         int acc = (int)c->output;
-        int delta = data_in ? (int)vol : -(int)vol;
-        acc += delta;
-        acc = CLAMP(acc, -128, 127);
+        while (clocks-- > 0)
+        {
+            lfsr = next[lfsr];
+            acc += (lfsr & 1) ? vol : -vol;
+            acc = CLAMP(acc, -128, 127);
+        }
         c->output = (s8)acc;
     }
-    else
+    else if (clocks > 0)
     {
-        int v = data_in ? (int)vol : -(int)vol;
+        lfsr = GetLFSRStateAfter(channel, clocks);
+        int v = (lfsr & 1) ? vol : -vol;
         v = CLAMP(v, -128, 127);
         c->output = (s8)v;
     }
 
+    c->internal_lfsr = lfsr;
+
     c->lfsr_low = (u8)(c->internal_lfsr & 0x00FF);
     c->other = (u8)((c->other & 0x0F) | ((c->internal_lfsr >> 4) & 0xF0));
+
+    if (c->output != previous_output)
+        m_audio_revision++;
 }
 
 INLINE void Mikey::RebuildTapsMask(GLYNX_Mikey_Audio* channel)
@@ -1573,6 +1658,10 @@ INLINE void Mikey::RebuildTapsMask(GLYNX_Mikey_Audio* channel)
     mask |= ((u16)(feedback & 0xC0)) << 4;
     mask |= (u16)(control & 0x80);
     channel->internal_taps_mask = mask;
+
+    u8 index = (u8)(channel - m_state.audio);
+    if (m_lfsr_table_mask[index] != mask)
+        RebuildLFSRTable(index);
 }
 
 INLINE void Mikey::RebuildLFSR(GLYNX_Mikey_Audio* channel)
@@ -1669,6 +1758,8 @@ INLINE void Mikey::UartRxReflectHead()
 
 INLINE void Mikey::UartRxPush(u8 data, bool parbit, bool parerr, bool framerr, bool rxbreak, u8 source)
 {
+    SyncUART();
+
     u8 flags = (parbit ? TRACE_MIKEY_UART_FLAG_PARITY_BIT : 0) |
         (parerr ? TRACE_MIKEY_UART_FLAG_PARITY_ERROR : 0) |
         (framerr ? TRACE_MIKEY_UART_FLAG_FRAMING_ERROR : 0) |
@@ -1855,6 +1946,8 @@ INLINE void Mikey::UartReceiveWire(bool level, bool peer_low)
 template<bool turbo>
 inline void Mikey::UartClock()
 {
+    SyncUART();
+
     // If break is asserted, keep line busy and do not advance a normal frame
     if (m_state.uart.tx_brk)
     {
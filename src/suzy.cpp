@@ -38,7 +38,15 @@ Suzy::Suzy(Media* media, M6502* m6502, Input* input, Bus* bus)
     InitPointer(m_memory);
     InitPointer(m_ram);
     InitPointer(m_trace_logger);
+    InitPointer(m_total_cycles);
     m_sprite_total_cycles = 0;
+    m_collision_batch_pending = false;
+    m_collision_batch_address = 0;
+    m_collision_batch_value = 0;
+    m_collision_reads = 0;
+    m_collision_writes = 0;
+    m_frame_collision_reads = 0;
+    m_frame_collision_writes = 0;
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     m_trace_math_op_a = 0;
     m_trace_math_op_b = 0;
@@ -53,6 +61,13 @@ Suzy::Suzy(Media* media, M6502* m6502, Input* input, Bus* bus)
     m_trace_sprite_active = false;
 #endif
     m_fast_sprite_rendering = false;
+    m_sprite_validation_enabled = false;
+    m_sprite_validation_running = false;
+    InitPointer(m_sprite_validation_ram);
+    m_sprite_validation_frame = 0;
+    m_sprite_validation_runs = 0;
+    m_sprite_validation_mismatch_count = 0;
+    m_sprite_validation_cycle_report_count = 0;
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     m_sprite_bounding_box_mode = GLYNX_SPRITE_BOUNDING_BOX_DISABLED;
     m_sprite_bounding_box_decay = 0;
@@ -62,17 +77,25 @@ Suzy::Suzy(Media* media, M6502* m6502, Input* input, Bus* bus)
     m_sprite_bounding_box_min_y = 0;
     m_sprite_bounding_box_max_x = 0;
     m_sprite_bounding_box_max_y = 0;
+    m_scb_accumulation_enabled = false;
+    m_scb_profile_index = -1;
+    m_scb_profile_start_cycles = 0;
+    m_scb_profile_pixels = 0;
+    m_scb_profile_source_bytes = 0;
+    m_scb_profile_collision_accesses = 0;
 #endif
     Reset();
 }
 Suzy::~Suzy()
 {
+    SafeDeleteArray(m_sprite_validation_ram);
 }
 
-void Suzy::Init(Memory* memory, Mikey* mikey)
+void Suzy::Init(Memory* memory, Mikey* mikey, const u64* total_cycles)
 {
     m_memory = memory;
     m_mikey = mikey;
+    m_total_cycles = total_cycles;
     m_ram = m_memory->GetRAM();
     ComputeQuadLUT();
     Reset();
@@ -280,6 +303,9 @@ void Suzy::LogCartridgeEvent(u8 event, u8 value, bool write, u8 bank)
 
 void Suzy::SignalBlitterDone()
 {
+    if (m_sprite_validation_running)
+        return;
+
     m_mikey->SetSuzyDone();
 }
 
@@ -288,6 +314,279 @@ void Suzy::SetFastSpriteRendering(bool enabled)
     m_fast_sprite_rendering = enabled;
 }
 
+void Suzy::SetSpriteValidation(bool enabled)
+{
+    if (enabled && !IsValidPointer(m_sprite_validation_ram))
+        m_sprite_validation_ram = new u8[0x10000];
+
+    m_sprite_validation_enabled = enabled;
+}
+
+bool Suzy::IsSpriteValidationEnabled()
+{
+    return m_sprite_validation_enabled;
+}
+
+u32 Suzy::GetSpriteValidationFrames()
+{
+    return m_sprite_validation_frame;
+}
+
+u32 Suzy::GetSpriteValidationRuns()
+{
+    return m_sprite_validation_runs;
+}
+
+u32 Suzy::GetSpriteValidationMismatchCount()
+{
+    return m_sprite_validation_mismatch_count;
+}
+
+std::vector<Suzy::GLYNX_Sprite_Validation_Mismatch>* Suzy::GetSpriteValidationMismatches()
+{
+    return &m_sprite_validation_mismatches;
+}
+
+u32 Suzy::GetSpriteValidationCycleReportCount()
+{
+    return m_sprite_validation_cycle_report_count;
+}
+
+std::vector<Suzy::GLYNX_Sprite_Validation_Mismatch>* Suzy::GetSpriteValidationCycleReports()
+{
+    return &m_sprite_validation_cycle_reports;
+}
+
+void Suzy::ClearSpriteValidation()
+{
+    m_sprite_validation_frame = 0;
+    m_sprite_validation_runs = 0;
+    m_sprite_validation_mismatch_count = 0;
+    m_sprite_validation_mismatches.clear();
+    m_sprite_validation_cycle_report_count = 0;
+    m_sprite_validation_cycle_reports.clear();
+}
+
+// Runs the SCB list with the fast renderer on RAM and, one SCB at a time,
+// replays it through the accurate blitter on a scratch copy of RAM.
+void Suzy::DrawSpritesValidated()
+{
+    Suzy_State accurate_state;
+    PrepareValidationState(&accurate_state);
+
+    u16 scb_address = m_state.SCBNEXT.value;
+    u32 fast_cycles = 0;
+    u32 accurate_cycles = 0;
+
+    memcpy(m_sprite_validation_ram, m_ram, 0x10000);
+
+    while ((m_state.SCBNEXT.value & 0xFF00) != 0)
+    {
+        if (fast_cycles > 0 || accurate_cycles > 0)
+            CompareValidationCycles(scb_address, fast_cycles, accurate_cycles);
+
+        scb_address = m_state.SCBNEXT.value;
+        u32 sprite_total_cycles = m_sprite_total_cycles;
+
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+        BeginSCBProfile();
+#endif
+        DrawSprite();
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+        EndSCBProfile();
+#endif
+
+        fast_cycles = m_sprite_total_cycles - sprite_total_cycles;
+        accurate_cycles = RunValidationSprite(&accurate_state);
+
+        // Restart the accurate blitter from the fast state so the next
+        // report is about the next SCB and not a consequence of this one
+        if (CompareValidationRam(scb_address))
+            PrepareValidationState(&accurate_state);
+    }
+
+    // The list terminator is charged to the last SCB in both renderers
+    while (accurate_state.fsm_phase != SUZY_PHASE_IDLE)
+        accurate_cycles += RunValidationSprite(&accurate_state);
+
+    CompareValidationRam(scb_address);
+    CompareValidationCycles(scb_address, fast_cycles, accurate_cycles);
+
+    m_sprite_validation_runs++;
+}
+
+void Suzy::PrepareValidationState(Suzy_State* accurate_state)
+{
+    *accurate_state = m_state;
+    accurate_state->fsm_phase = SUZY_PHASE_SCB_FETCH;
+    accurate_state->sprite_row_started = false;
+    accurate_state->row_pipeline_warm = false;
+    accurate_state->expansion_fifo_primed = false;
+    accurate_state->scb_control_line_pending = false;
+    accurate_state->spr_quadrant = 0;
+    accurate_state->quad_row = 0;
+    accurate_state->quad_pixel_height = -1;
+    accurate_state->row_emit_count = 0;
+}
+
+u32 Suzy::RunValidationSprite(Suzy_State* accurate_state)
+{
+    if (accurate_state->fsm_phase == SUZY_PHASE_IDLE)
+        return 0;
+
+    Suzy_State fast_state = m_state;
+    u8* ram = m_ram;
+    TraceLogger* trace_logger = m_trace_logger;
+    u32 sprite_total_cycles = m_sprite_total_cycles;
+    u32 collision_reads = m_collision_reads;
+    u32 collision_writes = m_collision_writes;
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+    bool trace_sprite_active = m_trace_sprite_active;
+    bool scb_accumulation_enabled = m_scb_accumulation_enabled;
+    GLYNX_Sprite_Bounding_Box_Mode bounding_box_mode = m_sprite_bounding_box_mode;
+    m_scb_accumulation_enabled = false;
+    m_sprite_bounding_box_mode = GLYNX_SPRITE_BOUNDING_BOX_DISABLED;
+#endif
+
+    m_state = *accurate_state;
+    m_ram = m_sprite_validation_ram;
+    InitPointer(m_trace_logger);
+    m_sprite_total_cycles = 0;
+    m_sprite_validation_running = true;
+
+    do
+    {
+        StepBlitterPhase();
+    }
+    while (m_state.fsm_phase != SUZY_PHASE_SCB_FETCH && m_state.fsm_phase != SUZY_PHASE_IDLE);
+
+    u32 cycles = m_sprite_total_cycles;
+    *accurate_state = m_state;
+
+    m_sprite_validation_running = false;
+    m_state = fast_state;
+    m_ram = ram;
+    m_trace_logger = trace_logger;
+    m_sprite_total_cycles = sprite_total_cycles;
+    m_collision_reads = collision_reads;
+    m_collision_writes = collision_writes;
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+    m_trace_sprite_active = trace_sprite_active;
+    m_scb_accumulation_enabled = scb_accumulation_enabled;
+    m_sprite_bounding_box_mode = bounding_box_mode;
+#endif
+
+    return cycles;
+}
+
+// The fast renderer only estimates its cycles, so only differences past
+// the tolerance are reported, and never as mismatches
+void Suzy::CompareValidationCycles(u16 scb_address, u32 fast_cycles, u32 accurate_cycles)
+{
+    u32 difference = fast_cycles > accurate_cycles ?
+            fast_cycles - accurate_cycles : accurate_cycles - fast_cycles;
+    u32 tolerance = MAX(k_suzy_validation_cycle_tolerance,
+            (accurate_cycles * k_suzy_validation_cycle_tolerance_percent) / 100);
+
+    if (difference <= tolerance)
+        return;
+
+    m_sprite_validation_cycle_report_count++;
+
+    if (m_sprite_validation_cycle_reports.size() >= 1024)
+        return;
+
+    GLYNX_Sprite_Validation_Mismatch report = {};
+    report.frame = m_sprite_validation_frame;
+    report.scb_address = scb_address;
+    report.cycles_differ = true;
+    report.x = -1;
+    report.y = -1;
+    report.fast_cycles = fast_cycles;
+    report.accurate_cycles = accurate_cycles;
+    m_sprite_validation_cycle_reports.push_back(report);
+}
+
+// Sprites only write the video and collision buffers and the collision
+// depository of the SCB, nothing else needs to be compared
+bool Suzy::CompareValidationRam(u16 scb_address)
+{
+    const u32 buffer_size = (GLYNX_SCREEN_WIDTH / 2) * GLYNX_SCREEN_HEIGHT;
+    u16 address = 0;
+
+    if (!FindValidationDifference(m_state.VIDBAS.value, buffer_size, &address) &&
+        !FindValidationDifference(m_state.COLLBAS.value, buffer_size, &address) &&
+        !FindValidationDifference((u16)(scb_address + m_state.COLLOFF.value), 1, &address))
+        return false;
+
+    GLYNX_Sprite_Validation_Mismatch mismatch = {};
+    mismatch.frame = m_sprite_validation_frame;
+    mismatch.scb_address = scb_address;
+    mismatch.address = address;
+    mismatch.fast_value = m_ram[address];
+    mismatch.accurate_value = m_sprite_validation_ram[address];
+    mismatch.x = -1;
+    mismatch.y = -1;
+
+    u16 video_offset = (u16)(address - m_state.VIDBAS.value);
+    u16 collision_offset = (u16)(address - m_state.COLLBAS.value);
+    u16 offset = video_offset;
+
+    if (video_offset >= (GLYNX_SCREEN_WIDTH / 2) * GLYNX_SCREEN_HEIGHT &&
+        collision_offset < (GLYNX_SCREEN_WIDTH / 2) * GLYNX_SCREEN_HEIGHT)
+    {
+        mismatch.collision_buffer = true;
+        offset = collision_offset;
+    }
+
+    if (offset < (GLYNX_SCREEN_WIDTH / 2) * GLYNX_SCREEN_HEIGHT)
+    {
+        bool high_nibble = ((mismatch.fast_value ^ mismatch.accurate_value) & 0xF0) != 0;
+        mismatch.x = (s16)((offset % (GLYNX_SCREEN_WIDTH / 2)) * 2 + (high_nibble ? 0 : 1));
+        mismatch.y = (s16)(offset / (GLYNX_SCREEN_WIDTH / 2));
+    }
+
+    AddValidationMismatch(mismatch);
+
+    // Resync so later SCBs are checked against the same starting point
+    memcpy(m_sprite_validation_ram, m_ram, 0x10000);
+    return true;
+}
+
+bool Suzy::FindValidationDifference(u16 base, u32 length, u16* address)
+{
+    u32 start = base;
+
+    while (length > 0)
+    {
+        u32 count = MIN(length, 0x10000 - start);
+
+        if (memcmp(m_ram + start, m_sprite_validation_ram + start, count) != 0)
+        {
+            while (m_ram[start] == m_sprite_validation_ram[start])
+                start++;
+
+            *address = (u16)start;
+            return true;
+        }
+
+        length -= count;
+        start = 0;
+    }
+
+    return false;
+}
+
+void Suzy::AddValidationMismatch(const GLYNX_Sprite_Validation_Mismatch& mismatch)
+{
+    m_sprite_validation_mismatch_count++;
+
+    if (m_sprite_validation_mismatches.size() < 1024)
+        m_sprite_validation_mismatches.push_back(mismatch);
+
+    Debug("Sprite validation mismatch: frame %d SCB $%04X", mismatch.frame, mismatch.scb_address);
+}
+
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
 void Suzy::SetSpriteBoundingBox(GLYNX_Sprite_Bounding_Box_Mode mode, int decay)
 {
@@ -316,6 +615,12 @@ void Suzy::Reset()
 {
     memset(&m_state, 0, sizeof(Suzy_State));
     m_sprite_total_cycles = 0;
+    m_collision_batch_pending = false;
+    m_collision_reads = 0;
+    m_collision_writes = 0;
+    m_frame_collision_reads = 0;
+    m_frame_collision_writes = 0;
+    ClearSpriteValidation();
     m_state.shift_register_bit = -1;
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     ResetTraceEventPairing();
@@ -331,6 +636,7 @@ void Suzy::Reset()
     m_sprite_bounding_box_list_display.clear();
 
     m_scb_accumulation_enabled = false;
+    m_scb_profile_index = -1;
     m_frame_scb_list.clear();
     m_frame_scb_list_display.clear();
 #endif
@@ -371,15 +677,15 @@ void Suzy::MathRunMultiply()
         REG_MATHM = sum & 0xFF;
     }
 
+    u32 math_cycles = 44 + ((m_state.sprsys_accumulate || m_state.sprsys_sign) ? 10 : 0);
     m_state.sprsys_unsafe = true;
-    m_state.sprsys_mathbusy = true;
-    m_state.math_cycles = 44 + ((m_state.sprsys_accumulate || m_state.sprsys_sign) ? 10 : 0);
+    m_state.math_done_cycle = *m_total_cycles + math_cycles;
 
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     ResetTraceMathEventPairing();
 #endif
     TraceMathOperationEvent(ab, cd, result, 0, false, m_state.sprsys_sign,
-        m_state.sprsys_accumulate, false, m_state.math_cycles);
+        m_state.sprsys_accumulate, false, math_cycles);
 }
 
 void Suzy::MathRunDivide()
@@ -420,15 +726,15 @@ void Suzy::MathRunDivide()
     REG_MATHL = (remainder >> 8) & 0xFF;
     REG_MATHM = remainder & 0xFF;
 
+    u32 math_cycles = 176 + (14 * l_zero16(divisor));
     m_state.sprsys_unsafe = true;
-    m_state.sprsys_mathbusy = true;
-    m_state.math_cycles = 176 + (14 * l_zero16(divisor));
+    m_state.math_done_cycle = *m_total_cycles + math_cycles;
 
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     ResetTraceMathEventPairing();
 #endif
     TraceMathOperationEvent(dividend, divisor, quotient, remainder, true, false,
-        false, zero_divisor, m_state.math_cycles);
+        false, zero_divisor, math_cycles);
 }
 
 void Suzy::ComputeQuadLUT()
@@ -490,6 +796,11 @@ void Suzy::LoadState(std::istream& stream, int version)
 
 void Suzy::Serialize(StateSerializer& s, int version)
 {
+    // The math unit keeps an absolute completion cycle, states store the
+    // remaining busy cycles so they stay independent of the master clock
+    bool math_busy = IsMathBusy();
+    u32 math_cycles = GetMathRemainingCycles();
+
     G_SERIALIZE(s, m_state.TMPADR);
     G_SERIALIZE(s, m_state.TILTACUM);
     G_SERIALIZE(s, m_state.HOFF);
@@ -527,13 +838,15 @@ void Suzy::Serialize(StateSerializer& s, int version)
     G_SERIALIZE(s, m_state.sprsys_lefthand);
     G_SERIALIZE(s, m_state.sprsys_unsafe);
     G_SERIALIZE(s, m_state.sprsys_stopsprites);
-    G_SERIALIZE(s, m_state.sprsys_mathbusy);
+    G_SERIALIZE(s, math_busy);
     G_SERIALIZE(s, m_state.sprsys_mathbit);
     G_SERIALIZE(s, m_state.sprsys_lastcarrybit);
     G_SERIALIZE(s, m_state.sprsys_spritesbusy);
     G_SERIALIZE_ARRAY(s, m_state.pen_map, 16);
     G_SERIALIZE(s, m_state.sprite_cycles);
-    G_SERIALIZE(s, m_state.math_cycles);
+    G_SERIALIZE(s, math_cycles);
+    if (s.IsLoading())
+        m_state.math_done_cycle = *m_total_cycles + (math_busy ? math_cycles : 0);
     G_SERIALIZE(s, m_state.math_sign_A);
     G_SERIALIZE(s, m_state.math_sign_C);
     G_SERIALIZE(s, m_state.shift_register_address);
@@ -72,13 +72,12 @@ public:
         bool sprsys_lefthand;
         bool sprsys_unsafe;
         bool sprsys_stopsprites;
-        bool sprsys_mathbusy;
         bool sprsys_mathbit;
         bool sprsys_lastcarrybit;
         bool sprsys_spritesbusy;
         u8 pen_map[16];
         u32 sprite_cycles;
-        u32 math_cycles;
+        u64 math_done_cycle;
         bool math_sign_A;
         bool math_sign_C;
         u16 shift_register_address;
@@ -150,7 +149,7 @@ public:
 public:
     Suzy(Media* media, M6502* m6502, Input* input, Bus* bus);
     ~Suzy();
-    void Init(Memory* memory, Mikey* mikey);
+    void Init(Memory* memory, Mikey* mikey, const u64* total_cycles);
     void Reset();
     void Clock(u32 cycles);
     u32 ApplyBusStall(u32* cycles, u32 stolen_cycles);
@@ -161,6 +160,33 @@ public:
     bool IsBusEnabled();
     void SetFastSpriteRendering(bool enabled);
     void SetTraceLogger(TraceLogger* trace_logger);
+    void EndFrame();
+    u32 GetFrameCollisionReads();
+    u32 GetFrameCollisionWrites();
+
+    struct GLYNX_Sprite_Validation_Mismatch
+    {
+        u32 frame;
+        u16 scb_address;
+        bool cycles_differ;
+        bool collision_buffer;
+        u16 address;
+        s16 x;
+        s16 y;
+        u8 fast_value;
+        u8 accurate_value;
+        u32 fast_cycles;
+        u32 accurate_cycles;
+    };
+    void SetSpriteValidation(bool enabled);
+    bool IsSpriteValidationEnabled();
+    u32 GetSpriteValidationFrames();
+    u32 GetSpriteValidationRuns();
+    u32 GetSpriteValidationMismatchCount();
+    std::vector<GLYNX_Sprite_Validation_Mismatch>* GetSpriteValidationMismatches();
+    u32 GetSpriteValidationCycleReportCount();
+    std::vector<GLYNX_Sprite_Validation_Mismatch>* GetSpriteValidationCycleReports();
+    void ClearSpriteValidation();
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     void ResetTraceEventPairing();
 #endif
@@ -193,6 +219,10 @@ public:
         bool skipped;
         s16 hoff;
         s16 voff;
+        u32 cycles;
+        u32 pixels;
+        u32 source_bytes;
+        u32 collision_accesses;
     };
     std::vector<GLYNX_SCB_Info>* GetFrameSCBList();
     void SwapFrameSCBList();
@@ -268,6 +298,13 @@ private:
     void SignalBlitterDone();
     void AdvanceSpriteRow(s32 dy, bool charge_transform_timing);
     void DrawSprite();
+    void DrawSpritesValidated();
+    void PrepareValidationState(Suzy_State* accurate_state);
+    u32 RunValidationSprite(Suzy_State* accurate_state);
+    void CompareValidationCycles(u16 scb_address, u32 fast_cycles, u32 accurate_cycles);
+    bool CompareValidationRam(u16 scb_address);
+    bool FindValidationDifference(u16 base, u32 length, u16* address);
+    void AddValidationMismatch(const GLYNX_Sprite_Validation_Mismatch& mismatch);
     u32 CalculateFastLiteralRowTicks(u32 source_bytes, u32 source_pixels,
             u32 output_pixels, s32 x, s32 dx, int bpp, u16 hsiz);
     void DrawSpriteLineLiteral(u16 data_begin, u16 data_end, s32 x, s32 y, s32 dx, int bpp, int type, u16 hsiz, u32 haccum_init, bool collide, u8 collision_id);
@@ -278,15 +315,22 @@ private:
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     void BeginSpriteBoundingBox();
     void AddSpriteBoundingBox();
+    void BeginSCBProfile();
+    void EndSCBProfile();
 #endif
     void AddPackedPixelTicks(bool pipeline_timing, bool charge_timing);
     void DrawPixel(s32 x, s32 y, u8 pen, int type, bool collide, u8 collision_id, bool pipeline_timing, int literal_bpp);
     u8 RamRead(u16 address);
     u16 RamReadWord(u16 address);
     void RamWrite(u16 address, u8 value);
+    u8 CollisionRead(u16 address, bool batched);
+    void CollisionWrite(u16 address, u8 value, bool batched);
+    void FlushCollisionBatch();
+    void FlushCollisionBatchAt(u16 address);
     void ShiftRegisterReset(u16 address, bool pipeline_timing);
     u32 ShiftRegisterGetBits(int n, u16 stop_addr, bool pipeline_timing);
-    void UpdateMath(u32 cycles);
+    bool IsMathBusy();
+    u32 GetMathRemainingCycles();
     void MathRunMultiply();
     void MathRunDivide();
     bool MathIsNegative(u16 value);
@@ -327,7 +371,15 @@ private:
     Suzy_State m_state;
     u8* m_ram;
     TraceLogger* m_trace_logger;
+    const u64* m_total_cycles;
     u32 m_sprite_total_cycles;
+    bool m_collision_batch_pending;
+    u16 m_collision_batch_address;
+    u8 m_collision_batch_value;
+    u32 m_collision_reads;
+    u32 m_collision_writes;
+    u32 m_frame_collision_reads;
+    u32 m_frame_collision_writes;
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     u32 m_trace_math_op_a;
     u32 m_trace_math_op_b;
@@ -343,6 +395,15 @@ private:
 #endif
     QuadPos m_quad_lut[4][4][4] = {};
     bool m_fast_sprite_rendering;
+    bool m_sprite_validation_enabled;
+    bool m_sprite_validation_running;
+    u8* m_sprite_validation_ram;
+    u32 m_sprite_validation_frame;
+    u32 m_sprite_validation_runs;
+    u32 m_sprite_validation_mismatch_count;
+    std::vector<GLYNX_Sprite_Validation_Mismatch> m_sprite_validation_mismatches;
+    u32 m_sprite_validation_cycle_report_count;
+    std::vector<GLYNX_Sprite_Validation_Mismatch> m_sprite_validation_cycle_reports;
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     GLYNX_Sprite_Bounding_Box_Mode m_sprite_bounding_box_mode;
     int m_sprite_bounding_box_decay;
@@ -357,6 +418,11 @@ private:
     std::vector<GLYNX_SCB_Info> m_frame_scb_list;
     std::vector<GLYNX_SCB_Info> m_frame_scb_list_display;
     bool m_scb_accumulation_enabled;
+    int m_scb_profile_index;
+    u32 m_scb_profile_start_cycles;
+    u32 m_scb_profile_pixels;
+    u32 m_scb_profile_source_bytes;
+    u32 m_scb_profile_collision_accesses;
 #endif
 };
 
@@ -92,6 +92,10 @@ static const u32 k_suzy_lcd_dma_burst_ticks                 = 28;
 static const u32 k_suzy_bus_grant_overhead_ticks            = 10;
 static const u32 k_suzy_lcd_dma_overlappable_ticks          = 10;
 
+// Fast renderer cycle estimate tolerance in validation mode
+static const u32 k_suzy_validation_cycle_tolerance          = 64;
+static const u32 k_suzy_validation_cycle_tolerance_percent  = 50;
+
 #include "m6502.h"
 
 //#define GLYNX_DEBUG_SUZY
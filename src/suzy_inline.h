@@ -32,7 +32,15 @@ INLINE void Suzy::Clock(u32 cycles)
     if (m_state.fsm_phase != SUZY_PHASE_IDLE)
         StepBlitter(cycles);
 
-    UpdateMath(cycles);
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+    // Math results are ready at write time, only the completion trace
+    // needs to observe the end of the busy window
+    if (m_trace_math_valid && !IsMathBusy())
+    {
+        TraceMathCompletionEvent();
+        ResetTraceMathEventPairing();
+    }
+#endif
 }
 
 INLINE void Suzy::TraceMathOperationEvent(u32 op_a, u32 op_b, u32 result, u16 remainder,
@@ -356,11 +364,13 @@ INLINE u8 Suzy::Read(u16 address)
         ret |= (m_state.sprsys_vstrech ? 0x10 : 0x00);
         ret |= (m_state.sprsys_lastcarrybit ? 0x20 : 0x00);
         ret |= (m_state.sprsys_mathbit ? 0x40 : 0x00);
-        ret |= (m_state.sprsys_mathbusy ? 0x80 : 0x00);
+        ret |= (IsMathBusy() ? 0x80 : 0x00);
         return ret;
     }
     case SUZY_JOYSTICK:    // 0xFCB0
     {
+        if (!debug)
+            m_input->Poll();
         u8 joy = m_input->ReadJoystick();
         DebugSuzy("Reading JOYSTICK: %02X", joy);
         if (!debug)
@@ -369,6 +379,8 @@ INLINE u8 Suzy::Read(u16 address)
     }
     case SUZY_SWITCHES:    // 0xFCB1
     {
+        if (!debug)
+            m_input->Poll();
         u8 sw = m_input->ReadSwitches();
         DebugSuzy("Reading SWITCHES: %02X", sw);
         if (!debug)
@@ -800,6 +812,27 @@ INLINE bool Suzy::IsBusEnabled()
     return IS_SET_BIT(m_state.SUZYBUSEN, 0);
 }
 
+INLINE void Suzy::EndFrame()
+{
+    if (m_sprite_validation_enabled)
+        m_sprite_validation_frame++;
+
+    m_frame_collision_reads = m_collision_reads;
+    m_frame_collision_writes = m_collision_writes;
+    m_collision_reads = 0;
+    m_collision_writes = 0;
+}
+
+INLINE u32 Suzy::GetFrameCollisionReads()
+{
+    return m_frame_collision_reads;
+}
+
+INLINE u32 Suzy::GetFrameCollisionWrites()
+{
+    return m_frame_collision_writes;
+}
+
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
 INLINE std::vector<Suzy::GLYNX_SCB_Info>* Suzy::GetFrameSCBList()
 {
@@ -810,6 +843,7 @@ INLINE void Suzy::SwapFrameSCBList()
 {
     if (m_scb_accumulation_enabled)
     {
+        EndSCBProfile();
         m_frame_scb_list_display.swap(m_frame_scb_list);
         m_frame_scb_list.clear();
     }
@@ -820,6 +854,7 @@ INLINE void Suzy::SetSCBAccumulationEnabled(bool enabled)
     m_scb_accumulation_enabled = enabled;
     if (!enabled)
     {
+        m_scb_profile_index = -1;
         m_frame_scb_list.clear();
         m_frame_scb_list_display.clear();
     }
@@ -1484,9 +1519,20 @@ INLINE void Suzy::SpritesGo()
 
     if (m_fast_sprite_rendering)
     {
-        while ((m_state.SCBNEXT.value & 0xFF00) != 0)
+        if (unlikely(m_sprite_validation_enabled))
+            DrawSpritesValidated();
+        else
         {
-            DrawSprite();
+            while ((m_state.SCBNEXT.value & 0xFF00) != 0)
+            {
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+                BeginSCBProfile();
+#endif
+                DrawSprite();
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+                EndSCBProfile();
+#endif
+            }
         }
 
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
@@ -1535,6 +1581,7 @@ INLINE void Suzy::FinishBlitter()
     DebugSuzy("SpritesGo finished: total cycles = %d", m_sprite_total_cycles);
 
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
+    EndSCBProfile();
     TraceSpriteEvent(TRACE_SUZY_SPRITE_ENGINE_END);
     m_trace_sprite_active = false;
 #endif
@@ -1627,6 +1674,11 @@ INLINE void Suzy::StepBlitterPhase()
 
             DebugSuzy("Drawing sprite at SCB %04X", m_state.SCBNEXT.value);
 
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+            EndSCBProfile();
+            BeginSCBProfile();
+#endif
+
             m_state.SCBADR.value = m_state.SCBNEXT.value;
             m_state.TMPADR.value = m_state.SCBADR.value;
 
@@ -1668,6 +1720,7 @@ INLINE void Suzy::StepBlitterPhase()
                     si.hoff = (s16)m_state.HOFF.value;
                     si.voff = (s16)m_state.VOFF.value;
                     m_frame_scb_list.push_back(si);
+                    m_scb_profile_index = (int)m_frame_scb_list.size() - 1;
                 }
 #endif
                 m_state.fsm_phase = SUZY_PHASE_SCB_NEXT;
@@ -1796,6 +1849,7 @@ INLINE void Suzy::StepBlitterPhase()
                 si.voff = (s16)m_state.VOFF.value;
                 memcpy(si.pen_map, m_state.pen_map, 16);
                 m_frame_scb_list.push_back(si);
+                m_scb_profile_index = (int)m_frame_scb_list.size() - 1;
             }
 
             TraceSpriteEvent(TRACE_SUZY_SPRITE_SCB);
@@ -1826,6 +1880,10 @@ INLINE void Suzy::StepBlitterPhase()
         {
             u16 line_address = m_state.SPRDLINE.value;
             u8 sprdoff = RamRead(line_address);
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+            if (unlikely(m_scb_accumulation_enabled))
+                m_scb_profile_source_bytes++;
+#endif
             bool literal_1bpp_record = sprdoff > 1 && m_state.sprite_row_started &&
                 IS_SET_BIT(m_state.SPRCTL1, 7) && (m_state.SPRCTL0 & 0xC0) == 0;
             AddSpriteCycles(literal_1bpp_record ?
@@ -2217,7 +2275,7 @@ INLINE void Suzy::StepBlitterPhase()
                     case 4:
                     case 6:
                     case 7:
-                        RamWrite(colpos, m_state.fred);
+                        CollisionWrite(colpos, m_state.fred, false);
                         break;
                     default:
                         break;
@@ -2226,14 +2284,22 @@ INLINE void Suzy::StepBlitterPhase()
 
             if (IS_SET_BIT(m_state.SPRGO, 2))
             {
-                u8 depository = RamRead(colpos);
+                u8 depository = CollisionRead(colpos, false);
                 depository = m_state.everon ? UNSET_BIT(depository, 7) : SET_BIT(depository, 7);
-                RamWrite(colpos, depository);
+                CollisionWrite(colpos, depository, false);
             }
 
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
             if ((collide && type >= 2 && type != 5) || IS_SET_BIT(m_state.SPRGO, 2))
                 TraceSpriteEvent(TRACE_SUZY_SPRITE_COLLISION);
+
+            if (unlikely(m_scb_accumulation_enabled))
+            {
+                if (collide && type >= 2 && type != 5)
+                    m_scb_profile_collision_accesses++;
+                if (IS_SET_BIT(m_state.SPRGO, 2))
+                    m_scb_profile_collision_accesses += 2;
+            }
 #endif
 
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
@@ -2493,6 +2559,7 @@ INLINE void Suzy::DrawSprite()
             si.hoff = (s16)m_state.HOFF.value;
             si.voff = (s16)m_state.VOFF.value;
             m_frame_scb_list.push_back(si);
+            m_scb_profile_index = (int)m_frame_scb_list.size() - 1;
         }
 #endif
         return;
@@ -2601,6 +2668,7 @@ INLINE void Suzy::DrawSprite()
         si.voff = (s16)m_state.VOFF.value;
         memcpy(si.pen_map, m_state.pen_map, 16);
         m_frame_scb_list.push_back(si);
+        m_scb_profile_index = (int)m_frame_scb_list.size() - 1;
     }
 #endif
 
@@ -2633,6 +2701,10 @@ INLINE void Suzy::DrawSprite()
     {
         u16 line_address = m_state.SPRDLINE.value;
         u8 sprdoff = RamRead(line_address);
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+        if (unlikely(m_scb_accumulation_enabled))
+            m_scb_profile_source_bytes++;
+#endif
         AddSpriteCycles(k_suzy_ram_read_ticks);  // sprdoff byte
         u16 next_ptr = (u16)(line_address + (u16)sprdoff);
 
@@ -2702,6 +2774,8 @@ INLINE void Suzy::DrawSprite()
                 DrawSpriteLinePacked(data_begin, data_end, start_x, cur_y, dx, bpp, type, m_state.SPRHSIZ.value, haccum_init, collide, collision_id);
             }
 
+            FlushCollisionBatch();
+
             bool visible_y = ((u32)cur_y < (u32)GLYNX_SCREEN_HEIGHT);
             bool away_y = (cur_y < 0 && dy < 0) ||
                     (cur_y >= GLYNX_SCREEN_HEIGHT && dy > 0);
@@ -2758,7 +2832,7 @@ INLINE void Suzy::DrawSprite()
             case 4: // NORMAL
             case 6: // XOR
             case 7: // SHADOW
-                RamWrite(colpos, m_state.fred);
+                CollisionWrite(colpos, m_state.fred, false);
                 break;
             default:
                 // BACKGROUND, BACKGROUND NON-COLLIDING, NON-COLLIDABLE
@@ -2768,14 +2842,22 @@ INLINE void Suzy::DrawSprite()
 
     if (IS_SET_BIT(m_state.SPRGO, 2))
     {
-        u8 depository = RamRead(colpos);
+        u8 depository = CollisionRead(colpos, false);
         depository = m_state.everon ? UNSET_BIT(depository, 7) : SET_BIT(depository, 7);
-        RamWrite(colpos, depository);
+        CollisionWrite(colpos, depository, false);
     }
 
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
     if ((collide && type >= 2 && type != 5) || IS_SET_BIT(m_state.SPRGO, 2))
         TraceSpriteEvent(TRACE_SUZY_SPRITE_COLLISION);
+
+    if (unlikely(m_scb_accumulation_enabled))
+    {
+        if (collide && type >= 2 && type != 5)
+            m_scb_profile_collision_accesses++;
+        if (IS_SET_BIT(m_state.SPRGO, 2))
+            m_scb_profile_collision_accesses += 2;
+    }
 #endif
 
 #if !defined(GLYNX_DISABLE_DISASSEMBLER)
@@ -2813,6 +2895,32 @@ INLINE void Suzy::AddSpriteBoundingBox()
     box.y1 = m_sprite_bounding_box_max_y;
     m_sprite_bounding_box_list.push_back(box);
 }
+
+INLINE void Suzy::BeginSCBProfile()
+{
+    m_scb_profile_index = -1;
+    m_scb_profile_start_cycles = m_sprite_total_cycles;
+    m_scb_profile_pixels = 0;
+    m_scb_profile_source_bytes = 0;
+    m_scb_profile_collision_accesses = 0;
+}
+
+INLINE void Suzy::EndSCBProfile()
+{
+    if (m_scb_profile_index < 0)
+        return;
+
+    if ((size_t)m_scb_profile_index < m_frame_scb_list.size())
+    {
+        GLYNX_SCB_Info& si = m_frame_scb_list[m_scb_profile_index];
+        si.cycles = m_sprite_total_cycles - m_scb_profile_start_cycles;
+        si.pixels = m_scb_profile_pixels;
+        si.source_bytes = m_scb_profile_source_bytes;
+        si.collision_accesses = m_scb_profile_collision_accesses;
+    }
+
+    m_scb_profile_index = -1;
+}
 #endif
 
 INLINE u32 Suzy::CalculateFastLiteralRowTicks(u32 source_bytes, u32 source_pixels,
@@ -3207,14 +3315,18 @@ INLINE void Suzy::DrawPixel(s32 x, s32 y, u8 pen, int type, bool collide, u8 col
                 }
 
                 u16 coll_addr = m_state.COLLBAS.value + pixel_offset;
-                u8 back = RamRead(coll_addr);
+                u8 back = CollisionRead(coll_addr, !pipeline_timing);
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+                if (unlikely(m_scb_accumulation_enabled))
+                    m_scb_profile_collision_accesses += 2;
+#endif
 
                 if (is_left)
                     back = (u8)((back & 0x0F) | (collision_id << 4));
                 else
                     back = (u8)((back & 0xF0) | (collision_id & 0x0F));
 
-                RamWrite(coll_addr, back);
+                CollisionWrite(coll_addr, back, !pipeline_timing);
             }
         }
         else if (non_collidable && pen == 0x0E &&
@@ -3258,7 +3370,11 @@ INLINE void Suzy::DrawPixel(s32 x, s32 y, u8 pen, int type, bool collide, u8 col
             }
 
             u16 coll_addr = m_state.COLLBAS.value + pixel_offset;
-            u8 back = RamRead(coll_addr);
+            u8 back = CollisionRead(coll_addr, !pipeline_timing);
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+            if (unlikely(m_scb_accumulation_enabled))
+                m_scb_profile_collision_accesses += 2;
+#endif
             u8 back_nib = is_left ? (back >> 4) : (back & 0x0F);
 
             if (back_nib > m_state.fred)
@@ -3269,14 +3385,20 @@ INLINE void Suzy::DrawPixel(s32 x, s32 y, u8 pen, int type, bool collide, u8 col
             else
                 back = (u8)((back & 0xF0) | (collision_id & 0x0F));
 
-            RamWrite(coll_addr, back);
+            CollisionWrite(coll_addr, back, !pipeline_timing);
         }
     }
 
     if (!transparent)
     {
         u16 video_addr = m_state.VIDBAS.value + pixel_offset;
+        if (!pipeline_timing)
+            FlushCollisionBatchAt(video_addr);
         u8 video_byte = RamRead(video_addr);
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+        if (unlikely(m_scb_accumulation_enabled))
+            m_scb_profile_pixels++;
+#endif
         bool is_xor = ((type & 0x07) == 6);
         u8 new_nib = pen;
 
@@ -3330,12 +3452,63 @@ INLINE void Suzy::RamWrite(u16 address, u8 value)
     m_ram[address] = value;
 }
 
+INLINE u8 Suzy::CollisionRead(u16 address, bool batched)
+{
+    if (batched && m_collision_batch_pending)
+    {
+        if (m_collision_batch_address == address)
+            return m_collision_batch_value;
+
+        FlushCollisionBatch();
+    }
+
+    m_collision_reads++;
+    return RamRead(address);
+}
+
+INLINE void Suzy::CollisionWrite(u16 address, u8 value, bool batched)
+{
+    if (batched)
+    {
+        // Fast rendering keeps the nibble pair in flight and writes it once
+        m_collision_batch_pending = true;
+        m_collision_batch_address = address;
+        m_collision_batch_value = value;
+        return;
+    }
+
+    m_collision_writes++;
+    RamWrite(address, value);
+}
+
+INLINE void Suzy::FlushCollisionBatch()
+{
+    if (!m_collision_batch_pending)
+        return;
+
+    m_collision_batch_pending = false;
+    m_collision_writes++;
+    RamWrite(m_collision_batch_address, m_collision_batch_value);
+}
+
+INLINE void Suzy::FlushCollisionBatchAt(u16 address)
+{
+    if (unlikely(m_collision_batch_pending && m_collision_batch_address == address))
+        FlushCollisionBatch();
+}
+
 INLINE void Suzy::ShiftRegisterReset(u16 address, bool pipeline_timing)
 {
     m_state.shift_register_address = address;
     m_state.PROCADR.value = address;
+    if (!pipeline_timing)
+        FlushCollisionBatchAt(address);
     m_state.shift_register_current = RamRead(address);
     m_state.shift_register_bit = 7;
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+    if (unlikely(m_scb_accumulation_enabled))
+        m_scb_profile_source_bytes++;
+#endif
     if (pipeline_timing)
         AddRowPipelineSourceByte();
 }
@@ -3367,8 +3540,14 @@ INLINE u32 Suzy::ShiftRegisterGetBits(int n, u16 stop_addr, bool pipeline_timing
 
     m_state.shift_register_address++;
     m_state.PROCADR.value = m_state.shift_register_address;
+    if (!pipeline_timing)
+        FlushCollisionBatchAt(m_state.shift_register_address);
     m_state.shift_register_current = RamRead(m_state.shift_register_address);
     m_state.shift_register_bit = 7 - bits_from_next_byte;
+#if !defined(GLYNX_DISABLE_DISASSEMBLER)
+    if (unlikely(m_scb_accumulation_enabled))
+        m_scb_profile_source_bytes++;
+#endif
 
     if (pipeline_timing)
         AddRowPipelineSourceByte();
@@ -3377,27 +3556,14 @@ INLINE u32 Suzy::ShiftRegisterGetBits(int n, u16 stop_addr, bool pipeline_timing
     return (window >> (8 - bits_from_next_byte)) & mask;
 }
 
-INLINE void Suzy::UpdateMath(u32 cycles)
+INLINE bool Suzy::IsMathBusy()
 {
-    if (m_state.math_cycles > 0)
-    {
-        if (m_state.math_cycles > cycles)
-        {
-            m_state.math_cycles -= cycles;
-        }
-        else
-        {
-            DebugSuzy("Math operation completed");
-            m_state.math_cycles = 0;
-            m_state.sprsys_mathbusy = false;
-#if !defined(GLYNX_DISABLE_DISASSEMBLER)
-            TraceMathCompletionEvent();
-#endif
-#if !defined(GLYNX_DISABLE_DISASSEMBLER)
-            ResetTraceMathEventPairing();
-#endif
-        }
-    }
+    return *m_total_cycles < m_state.math_done_cycle;
+}
+
+INLINE u32 Suzy::GetMathRemainingCycles()
+{
+    return IsMathBusy() ? (u32)(m_state.math_done_cycle - *m_total_cycles) : 0;
 }
 
 INLINE bool Suzy::MathIsNegative(u16 value)
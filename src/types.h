@@ -52,6 +52,31 @@ struct GLYNX_Runtime_Info
     int screen_width;
     int screen_height;
     float frame_time;
+    u32 collision_reads;
+    u32 collision_writes;
+};
+
+typedef void (*GLYNX_Input_Poll_Callback)(void* user_data);
+
+struct GLYNX_Input_Poll_Stats
+{
+    u32 frames;
+    u32 polled_frames;
+    u32 min_line;
+    u32 max_line;
+    u64 line_sum;
+    u32 last_line;
+};
+
+struct GLYNX_Frame_Profile
+{
+    u32 frames;
+    u64 cpu_ns;
+    u64 suzy_ns;
+    u64 mikey_ns;
+    u64 audio_ns;
+    u64 lcd_ns;
+    bool components;
 };
 
 enum GLYNX_Console_Type
@@ -80,6 +105,10 @@ enum GLYNX_Pixel_Format
 {
     GLYNX_PIXEL_RGB565,
     GLYNX_PIXEL_RGBA8888,
+    GLYNX_PIXEL_BGRA8888,
+    GLYNX_PIXEL_XRGB8888,
+    GLYNX_PIXEL_RGB555,
+    GLYNX_PIXEL_INDEXED12,
 };
 
 enum GLYNX_Disassembler_Syntax
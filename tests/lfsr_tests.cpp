@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <cstdlib>
+#include "gearlynx.h"
+#include "mikey.h"
+#include "mikey_defines.h"
+
+bool g_mcp_stdio_mode = false;
+
+static u32 s_random = 0x13579BDF;
+
+static u32 Random(u32 range)
+{
+    s_random = s_random * 1664525u + 1013904223u;
+    return (s_random >> 8) % range;
+}
+
+static void Check(bool condition, const char* message, int step)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "FAIL at step %d: %s\n", step, message);
+        exit(1);
+    }
+}
+
+struct Reference
+{
+    u16 lfsr;
+    u16 taps;
+    int volume;
+    int output;
+    bool integrate;
+};
+
+// One clock computed from the taps parity, independent of the core tables
+static void StepReference(Reference* r)
+{
+    u16 taps = r->lfsr & r->taps;
+    u8 parity = 0;
+
+    while (taps != 0)
+    {
+        parity ^= (u8)(taps & 1);
+        taps >>= 1;
+    }
+
+    r->lfsr = (u16)(((r->lfsr << 1) & 0x0FFE) | (parity ^ 1u));
+
+    int v = (r->lfsr & 1) ? r->volume : -r->volume;
+
+    if (r->integrate)
+        v += r->output;
+
+    r->output = CLAMP(v, -128, 127);
+}
+
+static void WriteChannel(Mikey* mikey, int channel, int reg, u8 value)
+{
+    mikey->Write<true>((u16)(MIKEY_AUD0VOL + channel * 8 + reg), value);
+}
+
+static u8 ReadChannel(Mikey* mikey, int channel, int reg)
+{
+    return mikey->Read<true>((u16)(MIKEY_AUD0VOL + channel * 8 + reg));
+}
+
+static u16 ReadLFSR(Mikey* mikey, int channel)
+{
+    return (u16)(ReadChannel(mikey, channel, 3) | ((ReadChannel(mikey, channel, 7) & 0xF0) << 4));
+}
+
+int main()
+{
+    GearlynxCore walk_core;
+    GearlynxCore stepping_core;
+    walk_core.Init();
+    stepping_core.Init();
+
+    Mikey* walk = walk_core.GetMikey();
+    Mikey* stepping = stepping_core.GetMikey();
+
+    walk->Reset(true);
+    stepping->Reset(true);
+
+    const int k_steps = 20000;
+    u32 total_clocks = 0;
+
+    for (int step = 0; step < k_steps; step++)
+    {
+        int channel = (int)Random(4);
+        u8 volume = (u8)Random(256);
+        u8 feedback = (u8)Random(256);
+        u8 control = (u8)((Random(2) << 7) | (Random(2) << 5));
+        u8 output = (u8)Random(256);
+        u16 lfsr = (u16)Random(4096);
+
+        // Counting stays disabled, only AdvanceLFSR() clocks the channel
+        Mikey* mikeys[2] = { walk, stepping };
+        for (int m = 0; m < 2; m++)
+        {
+            WriteChannel(mikeys[m], channel, 0, volume);
+            WriteChannel(mikeys[m], channel, 1, feedback);
+            WriteChannel(mikeys[m], channel, 5, control);
+            WriteChannel(mikeys[m], channel, 2, output);
+            WriteChannel(mikeys[m], channel, 3, (u8)(lfsr & 0xFF));
+            WriteChannel(mikeys[m], channel, 7, (u8)((lfsr >> 4) & 0xF0));
+        }
+
+        Reference reference;
+        reference.lfsr = lfsr;
+        reference.taps = (u16)((feedback & 0x3F) | ((feedback & 0xC0) << 4) | (control & 0x80));
+        reference.volume = (s8)volume;
+        reference.output = (s8)output;
+        reference.integrate = (control & 0x20) != 0;
+
+        u32 clocks = (Random(8) == 0) ? Random(20000) : 1 + Random(64);
+        total_clocks += clocks;
+
+        u16 predicted = walk->GetLFSRStateAfter((u8)channel, clocks);
+        walk->AdvanceLFSR((u8)channel, clocks);
+
+        for (u32 i = 0; i < clocks; i++)
+        {
+            stepping->AdvanceLFSR((u8)channel);
+            StepReference(&reference);
+        }
+
+        Check(ReadLFSR(walk, channel) == reference.lfsr, "table walk matches the parity reference", step);
+        Check(predicted == reference.lfsr, "GetLFSRStateAfter() matches the parity reference", step);
+        Check(ReadLFSR(stepping, channel) == reference.lfsr, "single clocks match the parity reference", step);
+        Check((s8)ReadChannel(walk, channel, 2) == reference.output, "table walk output matches", step);
+        Check((s8)ReadChannel(stepping, channel, 2) == reference.output, "single clock output matches", step);
+    }
+
+    printf("Steps: %d, clocks: %u\n", k_steps, total_clocks);
+    printf("LFSR tests passed\n");
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include "gearlynx.h"
+#include "mikey.h"
+#include "mikey_defines.h"
+
+bool g_mcp_stdio_mode = false;
+
+static u32 s_random = 0x2468ACE1;
+
+static u32 Random(u32 range)
+{
+    s_random = s_random * 1664525u + 1013904223u;
+    return (s_random >> 8) % range;
+}
+
+static void Check(bool condition, const char* message, int step)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "FAIL at step %d: %s\n", step, message);
+        exit(1);
+    }
+}
+
+static std::string SaveMikey(Mikey* mikey)
+{
+    std::stringstream stream;
+    mikey->SaveState(stream);
+    return stream.str();
+}
+
+// Timers that can become passive plus their link chain, the video and
+// UART timers keep their reset setup
+static const int k_timers[] = { 1, 3, 5, 6, 7 };
+
+int main()
+{
+    GearlynxCore analytic_core;
+    GearlynxCore stepping_core;
+    analytic_core.Init();
+    stepping_core.Init();
+
+    Mikey* analytic = analytic_core.GetMikey();
+    Mikey* stepping = stepping_core.GetMikey();
+
+    analytic->Reset(true);
+    stepping->Reset(true);
+    analytic->SetAnalyticTimers(true);
+    stepping->SetAnalyticTimers(false);
+
+    const int k_steps = 200000;
+    int reads = 0;
+    int states = 0;
+
+    for (int step = 0; step < k_steps; step++)
+    {
+        u32 op = Random(100);
+
+        if (op < 40)
+        {
+            u32 cycles = 1 + Random((Random(8) == 0) ? 20000 : 400);
+            analytic->Clock(cycles);
+            stepping->Clock(cycles);
+        }
+        else if (op < 65)
+        {
+            int timer = k_timers[Random(5)];
+            int reg = (int)Random(4);
+            u8 value = (u8)Random(256);
+
+            // Keep IRQs rare so most configurations stay passive
+            if (reg == 1 && Random(4) != 0)
+                value &= 0x7F;
+
+            u16 address = (u16)(MIKEY_TIM0BKUP + timer * 4 + reg);
+            analytic->Write<true>(address, value);
+            stepping->Write<true>(address, value);
+        }
+        else if (op < 98)
+        {
+            u16 address = (Random(8) == 0) ? (u16)MIKEY_INTSET :
+                (u16)(MIKEY_TIM0BKUP + Random(8) * 4 + Random(4));
+            u8 a = analytic->Read<true>(address);
+            u8 b = stepping->Read<true>(address);
+
+            if (a != b)
+                fprintf(stderr, "register $%04X: analytic %02X stepping %02X\n", address, a, b);
+            Check(a == b, "register reads match", step);
+            reads++;
+        }
+        else
+        {
+            Check(SaveMikey(analytic) == SaveMikey(stepping), "save states match", step);
+            states++;
+        }
+    }
+
+    printf("Steps: %d, reads: %d, save states: %d\n", k_steps, reads, states);
+    printf("Mikey timer tests passed\n");
+    return 0;
+}
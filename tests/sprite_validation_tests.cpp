@@ -0,0 +1,251 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "gearlynx.h"
+#include "suzy.h"
+#include "suzy_defines.h"
+
+bool g_mcp_stdio_mode = false;
+
+static const u16 k_vidbas = 0xC000;
+static const u16 k_collbas = 0xE000;
+static const u16 k_colloff = 0x0020;
+static const u16 k_scb_base = 0x2000;
+static const u16 k_scb_stride = 0x0040;
+static const u16 k_data_base = 0x4000;
+static const u16 k_data_stride = 0x0400;
+
+static u32 s_random = 0x12345678;
+
+static u32 Random(u32 range)
+{
+    s_random = s_random * 1664525u + 1013904223u;
+    return (s_random >> 8) % range;
+}
+
+static void Check(bool condition, const char* message)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "FAIL: %s\n", message);
+        exit(1);
+    }
+}
+
+static void WriteWord(u8* ram, u16 address, u16 value)
+{
+    ram[address] = (u8)(value & 0xFF);
+    ram[(u16)(address + 1)] = (u8)(value >> 8);
+}
+
+static void WriteSuzyWord(Suzy* suzy, u16 address, u16 value)
+{
+    suzy->Write<true>(address, (u8)(value & 0xFF));
+    suzy->Write<true>((u16)(address + 1), (u8)(value >> 8));
+}
+
+// Random sprite data, one quadrant of lines terminated by a zero offset
+static void BuildSpriteData(u8* ram, u16 address, bool literal)
+{
+    int lines = 1 + Random(12);
+
+    for (int line = 0; line < lines; line++)
+    {
+        int bytes = 1 + Random(literal ? 12 : 6);
+        ram[address++] = (u8)(bytes + 1);
+
+        for (int i = 0; i < bytes; i++)
+            ram[address++] = (u8)Random(256);
+    }
+
+    ram[address] = 0x00;
+}
+
+static void BuildChain(u8* ram, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        u16 scb = (u16)(k_scb_base + i * k_scb_stride);
+        u16 data = (u16)(k_data_base + i * k_data_stride);
+        u16 next = (i + 1 < count) ? (u16)(scb + k_scb_stride) : 0x0000;
+        bool literal = Random(2) != 0;
+
+        u8 bpp = (u8)(Random(4) << 6);
+        u8 type = (u8)(Random(8));
+        u8 flips = (u8)(Random(4) << 4);
+
+        ram[scb + 0] = (u8)(bpp | flips | type);
+        ram[scb + 1] = (u8)((literal ? 0x80 : 0x00) | 0x10);
+        ram[scb + 2] = (u8)(Random(16) | (Random(4) == 0 ? 0x20 : 0x00));
+        WriteWord(ram, (u16)(scb + 3), next);
+        WriteWord(ram, (u16)(scb + 5), data);
+        WriteWord(ram, (u16)(scb + 7), (u16)(Random(200) - 20));
+        WriteWord(ram, (u16)(scb + 9), (u16)(Random(140) - 20));
+        WriteWord(ram, (u16)(scb + 11), (u16)(0x0080 + Random(0x0100)));
+        WriteWord(ram, (u16)(scb + 13), (u16)(0x0080 + Random(0x0100)));
+
+        for (int p = 0; p < 8; p++)
+            ram[scb + 15 + p] = (u8)Random(256);
+
+        ram[scb + k_colloff] = 0x00;
+
+        BuildSpriteData(ram, data, literal);
+    }
+}
+
+static void StartSprites(Suzy* suzy)
+{
+    WriteSuzyWord(suzy, SUZY_HOFFL, 0x0000);
+    WriteSuzyWord(suzy, SUZY_VOFFL, 0x0000);
+    WriteSuzyWord(suzy, SUZY_VIDBASL, k_vidbas);
+    WriteSuzyWord(suzy, SUZY_COLLBASL, k_collbas);
+    WriteSuzyWord(suzy, SUZY_COLLOFFL, k_colloff);
+    WriteSuzyWord(suzy, SUZY_HSIZOFFL, 0x007F);
+    WriteSuzyWord(suzy, SUZY_VSIZOFFL, 0x007F);
+    WriteSuzyWord(suzy, SUZY_SCBNEXTL, k_scb_base);
+    suzy->Write<true>(SUZY_SPRINIT, 0xF3);
+    suzy->Write<true>(SUZY_SPRSYS, 0x00);
+    suzy->Write<true>(SUZY_SUZYBUSEN, 0x01);
+    suzy->Write<true>(SUZY_SPRGO, 0x01);
+}
+
+static void PrintMismatches(Suzy* suzy)
+{
+    std::vector<Suzy::GLYNX_Sprite_Validation_Mismatch>* mismatches = suzy->GetSpriteValidationMismatches();
+
+    for (size_t i = 0; i < mismatches->size(); i++)
+    {
+        Suzy::GLYNX_Sprite_Validation_Mismatch& m = (*mismatches)[i];
+        printf("  frame %u SCB $%04X: %s $%04X (%d,%d) fast %02X accurate %02X\n",
+            m.frame, m.scb_address, m.collision_buffer ? "collision" : "video",
+            m.address, m.x, m.y, m.fast_value, m.accurate_value);
+    }
+}
+
+static void PrintCycleReports(Suzy* suzy)
+{
+    std::vector<Suzy::GLYNX_Sprite_Validation_Mismatch>* reports = suzy->GetSpriteValidationCycleReports();
+
+    for (size_t i = 0; i < reports->size(); i++)
+    {
+        Suzy::GLYNX_Sprite_Validation_Mismatch& m = (*reports)[i];
+        printf("  frame %u SCB $%04X: cycles fast %u accurate %u\n",
+            m.frame, m.scb_address, m.fast_cycles, m.accurate_cycles);
+    }
+}
+
+static int RunSyntheticChains(GearlynxCore* core)
+{
+    Suzy* suzy = core->GetSuzy();
+    u8* ram = core->GetMemory()->GetRAM();
+
+    suzy->SetFastSpriteRendering(true);
+    suzy->SetSpriteValidation(true);
+
+    const int k_chains = 200;
+    u32 cycle_reports = 0;
+
+    for (int chain = 0; chain < k_chains; chain++)
+    {
+        memset(ram, 0, 0x10000);
+        suzy->Reset();
+        suzy->ClearSpriteValidation();
+
+        int count = 1 + Random(8);
+        BuildChain(ram, count);
+        StartSprites(suzy);
+
+        Check(suzy->GetSpriteValidationRuns() == 1, "validation runs once per SPRGO");
+
+        // Both renderers must produce the same pixels. Cycle counts are only
+        // an estimate in the fast renderer, reports past the tolerance are
+        // counted but not checked, they only have to name an SCB of this chain.
+
+        if (suzy->GetSpriteValidationMismatchCount() != 0)
+        {
+            printf("chain %d (%d sprites):\n", chain, count);
+            PrintMismatches(suzy);
+            Check(false, "fast and accurate renderers write the same RAM");
+        }
+
+        std::vector<Suzy::GLYNX_Sprite_Validation_Mismatch>* reports = suzy->GetSpriteValidationCycleReports();
+
+        for (size_t i = 0; i < reports->size(); i++)
+        {
+            Suzy::GLYNX_Sprite_Validation_Mismatch& m = (*reports)[i];
+            int index = (m.scb_address - k_scb_base) / k_scb_stride;
+
+            Check(m.scb_address >= k_scb_base && index < count &&
+                ((m.scb_address - k_scb_base) % k_scb_stride) == 0,
+                "cycle report is attributed to an SCB of the chain");
+        }
+
+        cycle_reports += suzy->GetSpriteValidationCycleReportCount();
+    }
+
+    printf("Synthetic chains: %d, cycle estimates past tolerance: %u\n", k_chains, cycle_reports);
+    return 0;
+}
+
+// Runs a ROM headless with the validation mode on and prints the report
+static int RunRom(GearlynxCore* core, const char* bios_path, const char* rom_path, int frames)
+{
+    GLYNX_Bios_State bios_state = core->LoadBios(bios_path);
+
+    if (bios_state == BIOS_LOAD_FILE_ERROR || bios_state == BIOS_LOAD_INVALID_SIZE)
+    {
+        fprintf(stderr, "Unable to load BIOS %s\n", bios_path);
+        return 1;
+    }
+
+    if (!core->LoadROM(rom_path))
+    {
+        fprintf(stderr, "Unable to load ROM %s\n", rom_path);
+        return 1;
+    }
+
+    Suzy* suzy = core->GetSuzy();
+    suzy->SetFastSpriteRendering(true);
+    suzy->SetSpriteValidation(true);
+    suzy->ClearSpriteValidation();
+
+    u8* frame_buffer = new u8[GLYNX_SCREEN_WIDTH * GLYNX_SCREEN_WIDTH * 4];
+    s16* sample_buffer = new s16[GLYNX_AUDIO_BUFFER_SIZE];
+    int sample_count = 0;
+
+    for (int i = 0; i < frames; i++)
+        core->RunToVBlank(frame_buffer, sample_buffer, &sample_count, NULL, false);
+
+    printf("%s: %d frames, %u sprite lists, %u mismatches, %u cycle estimates past tolerance\n",
+        rom_path, frames, suzy->GetSpriteValidationRuns(), suzy->GetSpriteValidationMismatchCount(),
+        suzy->GetSpriteValidationCycleReportCount());
+    PrintMismatches(suzy);
+    PrintCycleReports(suzy);
+
+    SafeDeleteArray(frame_buffer);
+    SafeDeleteArray(sample_buffer);
+
+    return suzy->GetSpriteValidationMismatchCount() == 0 ? 0 : 2;
+}
+
+int main(int argc, char* argv[])
+{
+    GearlynxCore core;
+    core.Init();
+
+    if (argc >= 3)
+    {
+        int frames = (argc >= 4) ? atoi(argv[3]) : 600;
+        return RunRom(&core, argv[1], argv[2], frames);
+    }
+
+    if (argc != 1)
+    {
+        fprintf(stderr, "Usage: %s [<bios> <rom> [frames]]\n", argv[0]);
+        return 1;
+    }
+
+    RunSyntheticChains(&core);
+    printf("Sprite validation tests passed\n");
+    return 0;
+}